@@ -0,0 +1,353 @@
+#include "../includes/main_window.hpp"
+#include "../includes/highlight_engine.hpp"
+#include "../includes/cpp_lexer.hpp"
+#include "../includes/lexer_registry.hpp"
+#include "../includes/finding_store.hpp"
+#include "../includes/source_editor.hpp"
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QTemporaryDir>
+#include <QRandomGenerator>
+#include <QTextCursor>
+#include <QTextStream>
+#include <QFile>
+#include <QFileInfo>
+#include <cstdio>
+#include <algorithm>
+#include <functional>
+
+/**
+ * @file editor_bench.cpp
+ * @brief Latency benchmark of the highlighter and the main window editor.
+ *
+ * Generates synthetic C/C++ files of increasing size, or takes real files
+ * from the command line, and measures for each of them:
+ * - the lexer and HighlightEngine full-highlight throughput,
+ * - the time MainWindow takes to open and color the file,
+ * - per-keystroke latency percentiles in both editors,
+ * - the time to apply N findings to the open file,
+ * - the resident memory per line of the open document.
+ *
+ * Meant to run headless, with QT_QPA_PLATFORM=offscreen. A latency budget
+ * can be given so that CI fails when keystrokes get slower.
+ */
+
+namespace {
+const int WaitTimeoutMs = 120000;
+
+const char* const SnippetLines[] = {
+    "#include <vector>",
+    "/* Block comment that spans",
+    "   several lines of the file */",
+    "static const char* name%1 = \"value %1\"; // trailing comment",
+    "#define SQUARE%1(x) ((x) * (x))",
+    "template <typename T>",
+    "int function%1(const std::vector<T>& values, int count) {",
+    "    auto raw = R\"(raw string %1)\";",
+    "    for (int i = 0; i < count; ++i) {",
+    "        count += values.size() * 0x%1 + 3.5e2;",
+    "    }",
+    "    return count;",
+    "}",
+};
+
+/**
+ * @brief Generates a C++ source of a given number of lines.
+ * @param lines The number of lines.
+ * @return The source text.
+ */
+QString syntheticSource(int lines) {
+    const int snippetSize = int(sizeof(SnippetLines) / sizeof(SnippetLines[0]));
+    QString text;
+    text.reserve(lines * 40);
+    for (int line = 0; line < lines; ++line) {
+        text += QString::fromLatin1(SnippetLines[line % snippetSize]).arg(line / snippetSize);
+        text += QLatin1Char('\n');
+    }
+    return text;
+}
+
+/**
+ * @brief Returns the resident memory of the process.
+ * @return The resident set size in bytes, or -1 where it is not available.
+ */
+qint64 residentMemory() {
+    QFile status("/proc/self/status");
+    if (!status.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        return -1;
+    }
+    for (const QByteArray& line : status.readAll().split('\n')) {
+        if (line.startsWith("VmRSS:")) {
+            return line.mid(6).trimmed().split(' ').first().toLongLong() * 1024;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Processes events until a condition holds.
+ * @param done The condition.
+ * @return False if the condition did not hold before the timeout.
+ */
+bool waitFor(const std::function<bool()>& done) {
+    QElapsedTimer timer;
+    timer.start();
+    while (!done()) {
+        if (timer.elapsed() > WaitTimeoutMs) {
+            return false;
+        }
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+    }
+    return true;
+}
+
+struct Percentiles {
+    double p50 = 0;
+    double p90 = 0;
+    double p99 = 0;
+    double max = 0;
+};
+
+Percentiles percentiles(QVector<double> samples) {
+    Percentiles result;
+    if (samples.isEmpty()) {
+        return result;
+    }
+    std::sort(samples.begin(), samples.end());
+    auto at = [&samples](double fraction) {
+        return samples[qMin(samples.size() - 1, int(fraction * samples.size()))];
+    };
+    result.p50 = at(0.50);
+    result.p90 = at(0.90);
+    result.p99 = at(0.99);
+    result.max = samples.last();
+    return result;
+}
+
+double megabytesPerSecond(qint64 bytes, qint64 nanoseconds) {
+    return nanoseconds > 0 ? bytes / 1048576.0 / (nanoseconds / 1e9) : 0.0;
+}
+
+void printLatency(const char* label, const Percentiles& latency) {
+    std::printf("  %-28s p50 %8.3f ms  p90 %8.3f ms  p99 %8.3f ms  max %8.3f ms\n",
+                label, latency.p50, latency.p90, latency.p99, latency.max);
+}
+
+/**
+ * @brief Types characters at random lines of a document, timing each keystroke.
+ *
+ * A keystroke is timed up to the end of the event processing it triggers,
+ * so the highlighting and the repaint it schedules are included.
+ *
+ * @param document The document to edit.
+ * @param keystrokes The number of keystrokes.
+ * @return The latency of every keystroke in milliseconds.
+ */
+QVector<double> typeKeystrokes(QTextDocument* document, int keystrokes) {
+    QRandomGenerator random(42);
+    QVector<double> samples;
+    samples.reserve(keystrokes);
+    QElapsedTimer timer;
+    for (int i = 0; i < keystrokes; ++i) {
+        QTextCursor cursor(document->findBlockByNumber(random.bounded(document->blockCount())));
+        cursor.movePosition(QTextCursor::EndOfBlock);
+        timer.start();
+        // Opening a comment changes the lexer state of every following line
+        cursor.insertText(i % 16 == 0 ? "/*" : ";");
+        QCoreApplication::processEvents();
+        samples.append(timer.nsecsElapsed() / 1e6);
+        if (i % 16 == 0) {
+            cursor.insertText("*/");
+        }
+    }
+    QCoreApplication::processEvents();
+    return samples;
+}
+
+/**
+ * @brief Builds findings spread evenly over a file.
+ * @param filePath The file the findings belong to.
+ * @param lines The number of lines of the file.
+ * @param count The number of findings.
+ * @return The findings snapshot.
+ */
+FindingSnapshot syntheticFindings(const QString& filePath, int lines, int count) {
+    static const char* const levels[] = {"error", "warning", "note"};
+    QList<AuditResult> results;
+    results.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        AuditResult result(QFileInfo(filePath).fileName());
+        result.setFilePath(filePath);
+        result.setLine(1 + int(qint64(i) * lines / qMax(1, count)));
+        result.setColumn(1);
+        result.setRuleId(QString("bench-rule-%1").arg(i % 8));
+        result.setToolName("bench");
+        result.setLevel(levels[i % 3]);
+        result.setFingerprint(quint64(i) + 1);
+        result.addIssue(QString("Synthetic finding %1").arg(i));
+        results.append(result);
+    }
+    return FindingStore::fromResults(results);
+}
+
+/**
+ * @brief Measures the lexer and a HighlightEngine pass on a text.
+ * @param text The source text.
+ * @param keystrokes The number of keystrokes to time.
+ * @return The keystroke latencies of the highlighted editor.
+ */
+Percentiles benchHighlighter(const QString& text, int keystrokes) {
+    const qint64 bytes = text.toUtf8().size();
+    QElapsedTimer timer;
+
+    // Tokenizer alone
+    CppLexer lexer;
+    QVector<Lexer::Token> tokens;
+    int state = -1;
+    timer.start();
+    for (const QStringRef& line : text.splitRef(QLatin1Char('\n'))) {
+        tokens.clear();
+        state = lexer.tokenizeLine(line.toString(), state, tokens);
+    }
+    std::printf("  %-28s %10.1f MB/s\n", "lexer", megabytesPerSecond(bytes, timer.nsecsElapsed()));
+
+    // Full pass of the engine the main window uses, including the layout it triggers
+    SourceEditor editor;
+    editor.resize(1000, 800);
+    editor.show();
+    QTextDocument* document = new QTextDocument(&editor);
+    SourceEditor::prepareDocument(document);
+    document->setPlainText(text);
+    editor.setDocument(document);
+    HighlightEngine* engine = new HighlightEngine(&editor);
+    QCoreApplication::processEvents();
+    timer.start();
+    engine->setLexer(document, &lexer);
+    if (!waitFor([engine]() { return !engine->isHighlighting(); })) {
+        std::printf("  %-28s %10s\n", "HighlightEngine full", "timed out");
+    } else {
+        std::printf("  %-28s %10.1f MB/s\n", "HighlightEngine full", megabytesPerSecond(bytes, timer.nsecsElapsed()));
+    }
+
+    return percentiles(typeKeystrokes(document, keystrokes));
+}
+
+/**
+ * @brief Measures the main window editor on a file.
+ * @param window The main window.
+ * @param filePath The file to open.
+ * @param lines The number of lines of the file.
+ * @param keystrokes The number of keystrokes to time.
+ * @param findings The number of findings to apply.
+ * @return The keystroke latencies of the editor, empty for a read-only large file.
+ */
+Percentiles benchMainWindow(MainWindow& window, const QString& filePath, int lines,
+                            int keystrokes, int findings) {
+    SourceEditor* editor = window.getTextEditor();
+    QTextDocument* previous = editor->document();
+    qint64 memoryBefore = residentMemory();
+    QElapsedTimer timer;
+
+    // Open, then wait for the document to be shown and fully colored
+    timer.start();
+    window.openFile(filePath);
+    bool editable = !MainWindow::opensReadOnly(filePath);
+    if (editable) {
+        waitFor([editor, previous]() { return editor->document() != previous; });
+        std::printf("  %-28s %10.1f ms\n", "MainWindow open", timer.nsecsElapsed() / 1e6);
+        if (LexerRegistry::instance().lexerForFile(filePath)) {
+            waitFor([editor]() { return editor->document()->lastBlock().userState() >= 0; });
+            std::printf("  %-28s %10.1f ms\n", "MainWindow colored", timer.nsecsElapsed() / 1e6);
+        } else {
+            std::printf("  %-28s %10s\n", "MainWindow colored", "plain text");
+        }
+    } else {
+        std::printf("  %-28s %10.1f ms (read-only large file view)\n", "MainWindow open", timer.nsecsElapsed() / 1e6);
+    }
+
+    qint64 memoryAfter = residentMemory();
+    if (memoryBefore >= 0 && memoryAfter >= 0) {
+        std::printf("  %-28s %10.1f bytes\n", "memory per line", double(memoryAfter - memoryBefore) / qMax(1, lines));
+    }
+
+    FindingSnapshot snapshot = syntheticFindings(QFileInfo(filePath).absoluteFilePath(), lines, findings);
+    timer.start();
+    window.updateAuditResults(snapshot);
+    QCoreApplication::processEvents();
+    std::printf("  %-28s %10.1f ms (%d findings)\n", "apply findings", timer.nsecsElapsed() / 1e6, findings);
+    window.updateAuditResults(FindingStore::empty());
+
+    if (!editable) {
+        return Percentiles();
+    }
+    return percentiles(typeKeystrokes(editor->document(), keystrokes));
+}
+}
+
+int main(int argc, char* argv[]) {
+    QApplication app(argc, argv);
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Highlighter and editor latency benchmark");
+    parser.addHelpOption();
+    parser.addOption({"lines", "Comma-separated line counts of the synthetic files.", "counts",
+                      "1000,10000,100000,1000000"});
+    parser.addOption({"keystrokes", "Keystrokes timed per file.", "count", "500"});
+    parser.addOption({"findings", "Findings applied per file.", "count", "1000"});
+    parser.addOption({"max-keystroke-p99", "Fail when the editor p99 keystroke latency exceeds this.", "ms"});
+    parser.addPositionalArgument("files", "Real source files to measure as well.", "[files...]");
+    parser.process(app);
+
+    const int keystrokes = parser.value("keystrokes").toInt();
+    const int findings = parser.value("findings").toInt();
+    const double budget = parser.isSet("max-keystroke-p99") ? parser.value("max-keystroke-p99").toDouble() : -1;
+
+    QTemporaryDir directory;
+    if (!directory.isValid()) {
+        std::fprintf(stderr, "Cannot create a temporary directory\n");
+        return 1;
+    }
+
+    // Synthetic files are written to disk so MainWindow loads them as usual
+    QStringList files;
+    for (const QString& count : parser.value("lines").split(',', Qt::SkipEmptyParts)) {
+        QString path = directory.filePath(QString("synthetic_%1.cpp").arg(count.toInt()));
+        QFile file(path);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+            std::fprintf(stderr, "Cannot write %s\n", qPrintable(path));
+            return 1;
+        }
+        QTextStream(&file) << syntheticSource(count.toInt());
+        files.append(path);
+    }
+    files += parser.positionalArguments();
+
+    MainWindow window;
+    window.resize(1280, 900);
+    window.show();
+
+    bool withinBudget = true;
+    for (const QString& path : files) {
+        QFile file(path);
+        if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+            std::fprintf(stderr, "Cannot read %s\n", qPrintable(path));
+            return 1;
+        }
+        QString text = QString::fromUtf8(file.readAll());
+        const int lines = text.count(QLatin1Char('\n')) + 1;
+        std::printf("%s: %d lines, %.1f MB\n", qPrintable(QFileInfo(path).fileName()), lines,
+                    file.size() / 1048576.0);
+
+        printLatency("HighlightEngine keystroke", benchHighlighter(text, keystrokes));
+        Percentiles editor = benchMainWindow(window, path, lines, keystrokes, findings);
+        if (editor.max > 0) {
+            printLatency("MainWindow keystroke", editor);
+        }
+        if (budget >= 0 && editor.p99 > budget) {
+            std::printf("  p99 keystroke latency %.3f ms exceeds the budget of %.3f ms\n", editor.p99, budget);
+            withinBudget = false;
+        }
+        std::fflush(stdout);
+    }
+    return withinBudget ? 0 : 1;
+}
@@ -1,15 +1,23 @@
 #pragma once
 
-#include "audit_result.hpp"
+#include "finding_store.hpp"
 #include <QString>
+#include <QStringList>
 #include <QList>
 #include <QMap>
 
 class AuditCache {
 public:
-    QList<AuditResult> getCachedResults(const QString& file);
-    void cacheResults(const QString& file, const QList<AuditResult>& results);
+    bool hasCachedResults(const QString& file, const QString& runKey) const;
+    FindingSnapshot getCachedResults(const QString& file, const QString& runKey) const;
+    void cacheResults(const QString& file, const QString& runKey, const FindingSnapshot& results);
+    QStringList getRunKeys(const QString& file) const;
+    bool hasAnalysedContent(const QString& file) const;
+    QStringList getAnalysedContent(const QString& file) const;
+    void setAnalysedContent(const QString& file, const QStringList& lines);
+    void invalidate(const QString& file);
 
 private:
-    QMap<QString, QList<AuditResult>> cache;
-}; 
\ No newline at end of file
+    QMap<QString, QMap<QString, FindingSnapshot>> cache;
+    QMap<QString, QStringList> analysedContent;
+}; 
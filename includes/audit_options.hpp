@@ -0,0 +1,30 @@
+#pragma once
+
+#include <QString>
+#include <QStringList>
+#include <QList>
+
+class AuditOptions {
+public:
+    AuditOptions();
+
+    static AuditOptions fromString(const QString& options);
+    static QStringList knownTools();
+
+    void addTool(const QString& tool);
+    void setVerbosity(int level);
+    bool hasTool(const QString& tool) const;
+    bool isEmpty() const;
+    QStringList getTools() const { return tools; }
+    int getVerbosity() const { return verbosity; }
+    QList<AuditOptions> splitByTool() const;
+    AuditOptions withTools(const QStringList& subset) const;
+    static QString toolOfRun(const QString& driverName, const QStringList& tools);
+    QString cacheKey() const;
+    QString toString() const;
+
+private:
+    QStringList tools;
+    QStringList extraArguments;
+    int verbosity;
+};
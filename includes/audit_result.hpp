@@ -2,9 +2,23 @@
 
 #include <QString>
 #include <QList>
+#include <QtGlobal>
 
 class AuditResult {
 public:
+    enum Severity {
+        Info,
+        Warning,
+        Error
+    };
+
+    // Unit of the columns, from the SARIF run's columnKind
+    enum ColumnKind {
+        Utf16CodeUnits,
+        UnicodeCodePoints,
+        Utf8Bytes
+    };
+
     AuditResult(const QString& fileName);
     
     void addIssue(const QString& issue);
@@ -12,6 +26,7 @@ public:
     void setColumn(int columnNumber);
     void setEndLine(int endLineNumber);
     void setEndColumn(int endColumnNumber);
+    void setColumnKind(ColumnKind kind);
     void setFilePath(const QString& path);
     QString getSummary() const;
     QString getFileName() const;
@@ -21,19 +36,31 @@ public:
     int getColumn() const { return column; }
     int getEndLine() const { return endLine; }
     int getEndColumn() const { return endColumn; }
+    ColumnKind getColumnKind() const { return columnKind; }
     QString getMessage() const { return message; }
     QString getRuleId() const { return ruleId; }
     void setRuleId(const QString& id);
+    QString getToolName() const { return toolName; }
+    void setToolName(const QString& name);
+    QString getLevel() const { return level; }
+    void setLevel(const QString& sarifLevel);
+    Severity getSeverity() const;
+    quint64 getFingerprint() const { return fingerprint; }
+    void setFingerprint(quint64 value);
     bool hasLocationInfo() const { return line > 0; }
 
 private:
     QString fileName;
     QString filePath;
     QString ruleId;
+    QString toolName;
+    QString level;
     QList<QString> issues;
     int line;
     int column;
     int endLine;
     int endColumn;
+    ColumnKind columnKind;
+    quint64 fingerprint;
     QString message;
 }; 
\ No newline at end of file
@@ -1,7 +1,7 @@
 #pragma once
 
 #include "ui_component.hpp"
-#include "audit_result.hpp"
+#include "finding_store.hpp"
 #include <QWidget>
 #include <QList>
 
@@ -11,8 +11,8 @@ class AuditResultsView : public QWidget, public UIComponent {
 public:
     explicit AuditResultsView(QWidget* parent = nullptr);
     void render() override;
-    void displayResults(const QList<AuditResult>& results);
+    void displayResults(const FindingSnapshot& results);
 
 private:
-    QList<AuditResult> currentResults;
+    FindingSnapshot currentResults;
 }; 
\ No newline at end of file
@@ -1,10 +1,11 @@
 #pragma once
 
 #include "audit_result.hpp"
+#include "audit_options.hpp"
+#include "finding_store.hpp"
 #include "ctrace_cli.hpp"
 #include "parser.hpp"
 #include "audit_cache.hpp"
-#include "error_highlighter.hpp"
 #include <QString>
 #include <QList>
 
@@ -13,11 +14,17 @@ public:
     AuditService();
     ~AuditService();
     
-    QList<AuditResult> performAudit(const QString& file, const QString& options = "");
+    FindingSnapshot performAudit(const QString& file, const QString& options = "");
+    QStringList analysedContent(const QString& file) const;
+    static FindingSnapshot remapFindings(const QString& file, const FindingSnapshot& findings,
+                                         const QStringList& analysedContent, const QString& currentContent,
+                                         bool& needsReaudit);
 
 private:
+    void syncCache(const QString& file, const QStringList& content);
+    static QStringList readLines(const QString& file);
+
     CTraceCLI ctraceCLI;
     Parser parser;
     AuditCache auditCache;
-    ErrorHighlighter errorHighlighter;
 }; 
\ No newline at end of file
@@ -7,6 +7,7 @@
 #include <QPushButton>
 #include <QVBoxLayout>
 #include <QGroupBox>
+#include "audit_options.hpp"
 
 class CliOptionsPanel : public QWidget {
     Q_OBJECT
@@ -15,6 +16,7 @@ public:
     explicit CliOptionsPanel(QWidget* parent = nullptr);
     ~CliOptionsPanel();
 
+    AuditOptions getAuditOptions() const;
     QString getCommandOptions() const;
 
 signals:
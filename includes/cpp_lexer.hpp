@@ -0,0 +1,13 @@
+#pragma once
+
+#include "lexer.hpp"
+
+class CppLexer : public Lexer {
+public:
+    int tokenizeLine(const QString& text, int state, QVector<Token>& tokens) const override;
+
+private:
+    static TokenKind wordKind(const QChar* word, int length, bool& found);
+    static int internDelimiter(const QString& delimiter);
+    static QString delimiter(int index);
+};
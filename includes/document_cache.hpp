@@ -0,0 +1,49 @@
+#pragma once
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QHash>
+#include <QTextDocument>
+
+class DocumentCache : public QObject {
+    Q_OBJECT
+
+public:
+    struct ViewState {
+        int cursorPosition = 0;
+        int scrollValue = 0;
+    };
+
+    explicit DocumentCache(qint64 budget, QObject* parent = nullptr);
+
+    QTextDocument* document(const QString& path);
+    bool contains(const QString& path) const { return entries.contains(path); }
+    void insert(const QString& path, QTextDocument* document);
+    void remove(const QString& path);
+    void setCurrent(const QString& path);
+    void setDisplayed(const QTextDocument* document);
+    QStringList modifiedPaths() const;
+
+    ViewState viewState(const QString& path) const;
+    void setViewState(const QString& path, const ViewState& state);
+
+    qint64 budget() const { return memoryBudget; }
+    qint64 memoryUsage() const;
+    static qint64 estimateSize(const QTextDocument* document);
+
+private:
+    struct Entry {
+        QTextDocument* document;
+        ViewState view;
+        quint64 lastUsed;
+    };
+
+    void evict(const QString& keep = QString());
+
+    QHash<QString, Entry> entries;
+    QString current;
+    const QTextDocument* displayed;
+    quint64 clock;
+    qint64 memoryBudget;
+};
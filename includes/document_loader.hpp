@@ -0,0 +1,37 @@
+#pragma once
+
+#include "lexer.hpp"
+#include <QObject>
+#include <QString>
+#include <QTextDocument>
+#include <QThreadPool>
+#include <QAtomicInt>
+#include <QSharedPointer>
+
+class DocumentLoader : public QObject {
+    Q_OBJECT
+
+public:
+    explicit DocumentLoader(QObject* parent = nullptr);
+    ~DocumentLoader();
+
+    void load(const QString& path);
+    void cancel();
+
+    bool isLoading() const { return loading; }
+    const QString& filePath() const { return path; }
+
+signals:
+    void progress(qint64 bytesRead, qint64 totalBytes);
+    void loaded(const QString& path, QTextDocument* document, int longestLine, const Lexer* lexer);
+    void failed(const QString& path, const QString& error);
+
+private:
+    void reportProgress(int id, qint64 bytesRead, qint64 totalBytes);
+    void finish(int id, QTextDocument* document, int longestLine, const Lexer* lexer, const QString& error);
+
+    QThreadPool pool;
+    QSharedPointer<QAtomicInt> generation;
+    QString path;
+    bool loading;
+};
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "audit_result.hpp"
+#include "finding_store.hpp"
+#include "finding_index.hpp"
+#include "search_engine.hpp"
+#include "source_editor.hpp"
+#include <QObject>
+#include <QTextEdit>
+#include <QTextBlock>
+#include <QTextCursor>
+#include <QList>
+#include <QEvent>
+
+class EditorDecorator : public QObject {
+    Q_OBJECT
+
+public:
+    enum Layer {
+        FindingLayer,
+        PinnedLayer,
+        SearchLayer,
+        LayerCount
+    };
+
+    explicit EditorDecorator(SourceEditor* editor);
+
+    void setFindings(const FindingSnapshot& findings, const FindingIndex* index, int fileId);
+    bool hasFindings() const { return index != nullptr; }
+    void setSearch(const SearchEngine* engine);
+    void refreshSearch();
+    void setSelections(Layer layer, const QList<QTextEdit::ExtraSelection>& selections);
+    void addSelections(Layer layer, const QList<QTextEdit::ExtraSelection>& selections);
+    const QList<QTextEdit::ExtraSelection>& selections(Layer layer) const { return layers[layer]; }
+    void clear(Layer layer);
+    void clearAll();
+
+    static int columnPosition(const QTextBlock& block, int column, AuditResult::ColumnKind kind);
+    static QTextCursor codeCursor(const QTextBlock& block, const AuditResult& result);
+    static void appendFindingSelections(const QTextBlock& block, const AuditResult& result,
+                                        QList<QTextEdit::ExtraSelection>& selections);
+
+protected:
+    bool eventFilter(QObject* obj, QEvent* event) override;
+
+private slots:
+    void updateViewport();
+
+private:
+    void materialize(int firstLine, int lastLine);
+    void materializeFindings(int firstLine, int lastLine);
+    void materializeSearch(int firstLine, int lastLine);
+    void apply();
+
+    SourceEditor* textEditor;
+    FindingSnapshot findings;
+    const FindingIndex* index;
+    int fileId;
+    const SearchEngine* search;
+
+    // Lines (1-based, inclusive) whose decorations are materialized
+    int materializedFirst;
+    int materializedLast;
+
+    QList<QTextEdit::ExtraSelection> layers[LayerCount];
+};
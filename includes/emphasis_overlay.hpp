@@ -0,0 +1,40 @@
+#pragma once
+
+#include "source_editor.hpp"
+#include <QWidget>
+#include <QTextCursor>
+#include <QTimer>
+#include <QColor>
+#include <QRect>
+#include <QEvent>
+#include <QPaintEvent>
+
+class EmphasisOverlay : public QWidget {
+    Q_OBJECT
+
+public:
+    explicit EmphasisOverlay(SourceEditor* editor);
+
+    void start(const QTextCursor& cursor, const QColor& color);
+    void stop();
+    bool isActive() const { return blinkTimer->isActive(); }
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+    bool eventFilter(QObject* obj, QEvent* event) override;
+
+private slots:
+    void blink();
+    void updateTarget();
+
+private:
+    QRect targetRect() const;
+
+    SourceEditor* textEditor;
+    QTimer* blinkTimer;
+    QTextCursor cursor;
+    QColor color;
+    QRect currentRect;
+    bool visibleState;
+    int remainingBlinks;
+};
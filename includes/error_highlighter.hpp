@@ -1,10 +1,39 @@
 #pragma once
 
-#include "audit_result.hpp"
+#include "finding_store.hpp"
 #include <QString>
-#include <QList>
+#include <QVector>
+#include <QByteArray>
+#include <QIODevice>
 
 class ErrorHighlighter {
 public:
-    void highlightErrors(const QString& file, const QList<AuditResult>& results);
-}; 
\ No newline at end of file
+    enum Format {
+        Html,
+        Ansi
+    };
+
+    explicit ErrorHighlighter(Format format = Html);
+
+    void setContextLines(int lines) { contextLines = lines; }
+    void setSourceRoot(const QString& path) { sourceRoot = path; }
+    void setThreadCount(int count) { threadCount = count; }
+
+    bool writeReport(const FindingSnapshot& results, QIODevice* out, const QString& title = QString()) const;
+    QByteArray renderFile(const QString& path, const FindingSnapshot& results, const QVector<int>& rows) const;
+
+private:
+    QByteArray reportHeader(const QString& title, int fileCount, int findingCount) const;
+    QByteArray reportFooter() const;
+    QByteArray fileHeader(const QString& path, int findingCount) const;
+    QByteArray fileFooter() const;
+    QByteArray sourceLine(int number, const QString& text, const FindingSnapshot& results,
+                          const QVector<int>& active) const;
+    QByteArray annotation(const FindingSnapshot& results, int row) const;
+    QByteArray gap() const;
+
+    Format format;
+    int contextLines;
+    int threadCount;
+    QString sourceRoot;
+};
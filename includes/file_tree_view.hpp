@@ -13,6 +13,7 @@ class FileTreeView : public QTreeView {
 public:
     explicit FileTreeView(QWidget* parent = nullptr);
     void setRootPath(const QString& path);
+    QString rootPath() const;
 
 signals:
     void fileSelected(const QString& filePath);
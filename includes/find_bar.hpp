@@ -0,0 +1,39 @@
+#pragma once
+
+#include "search_engine.hpp"
+#include <QWidget>
+#include <QLineEdit>
+#include <QCheckBox>
+#include <QLabel>
+#include <QToolButton>
+#include <QKeyEvent>
+
+class FindBar : public QWidget {
+    Q_OBJECT
+
+public:
+    explicit FindBar(QWidget* parent = nullptr);
+    SearchEngine::Query query() const;
+    void activate();
+    void setStatus(const QString& status, bool error = false);
+
+signals:
+    void queryChanged();
+    void findNext();
+    void findPrevious();
+    void closed();
+
+protected:
+    bool eventFilter(QObject* obj, QEvent* event) override;
+
+private:
+    QLineEdit* searchEdit;
+    QCheckBox* caseCheckBox;
+    QCheckBox* regexCheckBox;
+    QLabel* statusLabel;
+    QToolButton* previousButton;
+    QToolButton* nextButton;
+    QToolButton* closeButton;
+
+    void setupUi();
+};
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "audit_result.hpp"
+#include "finding_store.hpp"
+#include <QString>
+#include <QList>
+#include <QVector>
+#include <QHash>
+
+class FindingIndex {
+public:
+    void build(const FindingStore& findings);
+    void clear();
+
+    int fileId(const QString& path) const;
+    int ruleId(const QString& rule) const;
+    QString filePath(int fileId) const;
+    int fileCount() const { return files.size(); }
+    int findingCount(int fileId) const;
+
+    QVector<int> findingsInRange(int fileId, int firstLine, int lastLine) const;
+    QVector<int> findingsAtLine(int fileId, int line) const;
+    QVector<int> query(int fileId, int firstLine, int lastLine,
+                       AuditResult::Severity minSeverity, int ruleId = -1) const;
+    int nextFinding(int fileId, int line) const;
+    int previousFinding(int fileId, int line) const;
+
+    static QString normalizePath(const QString& path);
+
+private:
+    struct Interval {
+        int start;
+        int end;
+        int maxEnd;
+        int row;
+        int ruleId;
+        AuditResult::Severity severity;
+    };
+
+    struct FileIntervals {
+        QVector<Interval> intervals;
+        int maxLevel;
+    };
+
+    int internFile(const QString& path);
+    int internRule(const QString& rule);
+    static int buildTree(QVector<Interval>& intervals);
+
+    QVector<QString> filePaths;
+    QHash<QString, int> fileIds;
+    QMultiHash<QString, int> fileIdsByName;
+    QHash<QString, int> ruleIds;
+    QVector<FileIntervals> files;
+};
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "finding_store.hpp"
+#include "line_diff.hpp"
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+class FindingRemapper {
+public:
+    FindingRemapper(const QStringList& analysedLines, const QStringList& currentLines);
+
+    bool isValid() const { return valid; }
+    bool hasCodeChanges() const { return codeChanged; }
+    bool changesFindings(const FindingSnapshot& findings, const QString& file) const;
+    FindingSnapshot remap(const FindingSnapshot& findings, const QString& file) const;
+
+private:
+    bool mapPosition(int line, int column, int& newLine, int& newColumn, bool& touched) const;
+    static int leadingWhitespace(const QString& line);
+
+    QStringList analysedLines;
+    QStringList currentLines;
+    QVector<LineDiff::Hunk> hunks;
+    QVector<int> lineDeltas;
+    QVector<bool> codeHunks;
+    bool valid;
+    bool codeChanged;
+};
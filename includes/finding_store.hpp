@@ -0,0 +1,98 @@
+#pragma once
+
+#include "audit_result.hpp"
+#include <QString>
+#include <QStringList>
+#include <QList>
+#include <QVector>
+#include <QHash>
+#include <QSet>
+#include <QSharedPointer>
+#include <functional>
+
+class FindingStore;
+
+typedef QSharedPointer<const FindingStore> FindingSnapshot;
+
+class FindingStore {
+public:
+    struct Location {
+        int line;
+        int column;
+        int endLine;
+        int endColumn;
+        bool stale;
+    };
+
+    static FindingSnapshot fromResults(const QList<AuditResult>& results);
+    static FindingSnapshot concat(const QList<FindingSnapshot>& parts);
+    static FindingSnapshot empty();
+
+    int size() const { return severities.size(); }
+    bool isEmpty() const { return severities.isEmpty(); }
+
+    AuditResult::Severity severity(int row) const { return AuditResult::Severity(severities[row]); }
+    int line(int row) const { return lines[row]; }
+    int column(int row) const { return columns[row]; }
+    int endLine(int row) const { return endLines[row]; }
+    int endColumn(int row) const { return endColumns[row]; }
+    AuditResult::ColumnKind columnKind(int row) const { return AuditResult::ColumnKind(flags[row] >> ColumnKindShift); }
+    bool hasLocationInfo(int row) const { return lines[row] > 0; }
+    bool isStale(int row) const { return flags[row] & StaleFlag; }
+    quint64 fingerprint(int row) const { return fingerprints[row]; }
+    bool contains(quint64 fingerprint) const { return fingerprintSet.contains(fingerprint); }
+    QVector<int> rowsNotIn(const FindingStore& other) const;
+
+    const QString& fileName(int row) const { return strings[fileNameIds[row]]; }
+    const QString& filePath(int row) const { return strings[filePathIds[row]]; }
+    const QString& ruleId(int row) const { return strings[ruleIds[row]]; }
+    const QString& toolName(int row) const { return strings[toolNameIds[row]]; }
+    const QString& level(int row) const { return strings[levelIds[row]]; }
+    int issueCount(int row) const { return issueOffsets[row + 1] - issueOffsets[row]; }
+    QStringList issues(int row) const;
+    QString message(int row) const;
+    QString summary(int row) const;
+
+    AuditResult toResult(int row) const;
+    FindingSnapshot relocated(const std::function<bool(int row, Location& location)>& relocate) const;
+
+private:
+    enum Flag {
+        StaleFlag = 0x1
+    };
+
+    // The column kind is packed in the flags, above the flag bits
+    static const int ColumnKindShift = 1;
+
+    FindingStore();
+
+    quint32 intern(const QString& value);
+    bool accept(quint64 fingerprint);
+    void append(const AuditResult& result);
+    void appendRow(const FindingStore& source, int row);
+
+    // One entry per finding
+    QVector<quint8> severities;
+    QVector<qint32> lines;
+    QVector<qint32> columns;
+    QVector<qint32> endLines;
+    QVector<qint32> endColumns;
+    QVector<quint32> fileNameIds;
+    QVector<quint32> filePathIds;
+    QVector<quint32> ruleIds;
+    QVector<quint32> toolNameIds;
+    QVector<quint32> levelIds;
+    QVector<quint8> flags;
+    QVector<quint64> fingerprints;
+    QVector<quint32> issueOffsets;
+
+    // Fingerprints of all rows, for O(1) duplicate checks
+    QSet<quint64> fingerprintSet;
+
+    // Issue lines of every finding, addressed through issueOffsets
+    QVector<quint32> issueIds;
+
+    // Interned strings shared by all columns
+    QVector<QString> strings;
+    QHash<QString, quint32> stringIds;
+};
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "lexer.hpp"
+#include "source_editor.hpp"
+#include <QObject>
+#include <QTextBlock>
+#include <QTextCharFormat>
+#include <QPointer>
+#include <QTimer>
+#include <QThreadPool>
+#include <QAtomicInt>
+#include <QSharedPointer>
+#include <QVector>
+#include <QHash>
+
+class HighlightEngine : public QObject {
+    Q_OBJECT
+
+public:
+    // Tokens of one line and the lexer states at its start and end
+    struct LineTokens {
+        QVector<Lexer::Token> tokens;
+        int startState = -1;
+        int state = -1;
+    };
+
+    explicit HighlightEngine(SourceEditor* editor);
+    ~HighlightEngine();
+
+    void attachDocument();
+    void setLexer(QTextDocument* document, const Lexer* lexer);
+    bool isHighlighting() const { return running || appliedCount < results.size(); }
+
+private slots:
+    void contentsChange(int position, int charsRemoved, int charsAdded);
+    void applyPending();
+
+private:
+    void start();
+    void cancel();
+    void receive(int id, int firstLine, const QVector<LineTokens>& lines);
+    void finish(int id);
+    void shiftPass(int firstLine, int added);
+    int currentLine(int passLine) const;
+    bool applyLine(int line, QTextBlock block);
+    void setFormats(QTextBlock block, const QVector<Lexer::Token>& tokens);
+    void rehighlight(QTextBlock block, const QTextBlock& last);
+
+    SourceEditor* textEditor;
+    QPointer<QTextDocument> document;
+    const Lexer* lexer;
+    QTextCharFormat formats[Lexer::TokenKindCount];
+    QThreadPool pool;
+    QSharedPointer<QAtomicInt> generation;
+    QTimer* idleTimer;
+
+    // Where the pass stands on each line of the document
+    enum LineStatus : quint8 {
+        Pending,  // Not tokenized yet
+        Received, // Tokens of the pass waiting to be applied
+        Edited,   // Changed during the pass, lexed when applied
+        Applied
+    };
+
+    // Lines replaced during the pass, in the line numbers of the time
+    struct Edit {
+        int firstLine;
+        int removed;
+        int added;
+    };
+
+    // Results of the running pass, indexed by the current line
+    QVector<LineTokens> results;
+    QVector<LineStatus> status;
+    QVector<Edit> edits;
+    int appliedCount;
+    int nextLine;
+    bool running;
+    bool applying;
+
+    // Lexer of every document, and whether all of its blocks are highlighted
+    struct DocumentState {
+        const Lexer* lexer = nullptr;
+        bool highlighted = false;
+    };
+    QHash<const QObject*, DocumentState> states;
+};
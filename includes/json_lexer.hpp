@@ -0,0 +1,8 @@
+#pragma once
+
+#include "lexer.hpp"
+
+class JsonLexer : public Lexer {
+public:
+    int tokenizeLine(const QString& text, int state, QVector<Token>& tokens) const override;
+};
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "mapped_text.hpp"
+#include "finding_store.hpp"
+#include "finding_index.hpp"
+#include "search_engine.hpp"
+#include <QAbstractScrollArea>
+#include <QString>
+#include <QVector>
+#include <QPaintEvent>
+#include <QResizeEvent>
+#include <QMouseEvent>
+#include <QThreadPool>
+#include <QAtomicInt>
+#include <QSharedPointer>
+#include <QPainter>
+
+class LargeFileView : public QAbstractScrollArea {
+    Q_OBJECT
+
+public:
+    explicit LargeFileView(QWidget* parent = nullptr);
+    ~LargeFileView();
+
+    bool open(const QString& path);
+    void close();
+    QString errorString() const { return text.errorString(); }
+    const QString& filePath() const { return path; }
+    int lineCount() const { return text.lineCount(); }
+    int currentLine() const { return cursorLine + 1; }
+
+    void goToLine(int line, int column = 1, AuditResult::ColumnKind kind = AuditResult::Utf16CodeUnits);
+    void setFindings(const FindingSnapshot& findings, const FindingIndex* index, int fileId);
+    void clearFindings();
+    void find(const SearchEngine::Query& query, bool backward);
+    void cancelFind();
+
+signals:
+    void findFinished(bool found);
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+    void resizeEvent(QResizeEvent* event) override;
+    void mousePressEvent(QMouseEvent* event) override;
+    bool viewportEvent(QEvent* event) override;
+
+private:
+    void updateScrollBars();
+    int visibleLineCount() const;
+    int gutterWidth() const;
+    QString displayText(int line) const;
+    bool isLongLine(int line) const;
+    int charWidth() const;
+    int columnX(int line, int column) const;
+    int displayColumn(int line, int column, AuditResult::ColumnKind kind) const;
+    void drawSlice(QPainter& painter, int line, qint64 offset, int maxBytes, int x, int baseline) const;
+    void ensureColumnVisible(int line, int column);
+    int lineAtY(int y) const;
+    void finishFind(int id, int line, int column, int length);
+
+    MappedText text;
+    QString path;
+    FindingSnapshot findings;
+    const FindingIndex* index;
+    int fileId;
+
+    int cursorLine;
+    int matchLine;
+    int matchColumn;
+    int matchLength;
+
+    QThreadPool findPool;
+    QSharedPointer<QAtomicInt> findGeneration;
+};
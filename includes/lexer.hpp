@@ -0,0 +1,39 @@
+#pragma once
+
+#include <QString>
+#include <QVector>
+
+class Lexer {
+public:
+    enum TokenKind {
+        Keyword,
+        Type,
+        Function,
+        Comment,
+        String,
+        Number,
+        Preprocessor,
+        TokenKindCount
+    };
+
+    struct Token {
+        int start;
+        int length;
+        TokenKind kind;
+    };
+
+    virtual ~Lexer() = default;
+
+    /**
+     * @brief Tokenizes one line.
+     *
+     * Implementations must be stateless, so that one instance can serve
+     * several documents and threads.
+     *
+     * @param text The text of the line, without its line break.
+     * @param state The state returned for the previous line, or a negative value for the first line.
+     * @param tokens Receives the tokens of the line, in order.
+     * @return The state at the end of the line.
+     */
+    virtual int tokenizeLine(const QString& text, int state, QVector<Token>& tokens) const = 0;
+};
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "lexer.hpp"
+#include <QString>
+#include <QStringList>
+#include <QByteArray>
+#include <QVector>
+#include <QHash>
+#include <QMutex>
+#include <QSharedPointer>
+#include <functional>
+
+class LexerRegistry {
+public:
+    typedef std::function<Lexer*()> Factory;
+    typedef std::function<bool(const QByteArray& head)> Sniffer;
+
+    static LexerRegistry& instance();
+
+    void registerLexer(const QString& name, const QStringList& extensions, const Factory& factory,
+                       const Sniffer& sniffer = Sniffer());
+    const Lexer* lexer(const QString& name);
+    const Lexer* lexerForFile(const QString& path);
+    const Lexer* lexerForContent(const QString& path, qint64 size, const QByteArray& head, int longestLine);
+
+    static const int SampleSize = 64 * 1024;
+
+private:
+    struct Entry {
+        QString name;
+        Factory factory;
+        Sniffer sniffer;
+        QSharedPointer<Lexer> lexer;
+    };
+
+    LexerRegistry();
+    const Lexer* load(int index);
+
+    QMutex mutex;
+    QVector<Entry> entries;
+    QHash<QString, int> names;
+    QHash<QString, int> extensions;
+};
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <QVector>
+#include <QStringList>
+
+class LineDiff {
+public:
+    struct Hunk {
+        int oldStart;
+        int oldCount;
+        int newStart;
+        int newCount;
+    };
+
+    static bool compute(const QVector<uint>& oldLines, const QVector<uint>& newLines,
+                        int maxEdits, QVector<Hunk>& hunks);
+    static QVector<uint> hashLines(const QStringList& lines);
+};
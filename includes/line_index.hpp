@@ -0,0 +1,15 @@
+#pragma once
+
+#include "audit_result.hpp"
+#include <QChar>
+#include <QVector>
+
+class LineIndex {
+public:
+    static int columnOffset(const QChar* line, int length, int column, AuditResult::ColumnKind kind);
+    static void scanLines(const QChar* data, int size, QVector<int>& lineStarts, QVector<bool>& asciiLines,
+                          bool vectorized = true);
+
+private:
+    LineIndex() = delete;
+};
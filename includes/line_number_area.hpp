@@ -1,19 +1,43 @@
 #ifndef LINE_NUMBER_AREA_HPP
 #define LINE_NUMBER_AREA_HPP
 
+#include "finding_store.hpp"
+#include "finding_index.hpp"
+#include "source_editor.hpp"
 #include <QWidget>
-#include <QTextEdit>
+#include <QPixmap>
+#include <QVector>
 
 class LineNumberArea : public QWidget {
 public:
-    LineNumberArea(QTextEdit* editor);
+    LineNumberArea(SourceEditor* editor);
+
+    void attachDocument();
+    void setFindings(const FindingSnapshot& findings, const FindingIndex* index, int fileId);
+    void clearFindings();
 
 protected:
     void paintEvent(QPaintEvent* event) override;
+    void changeEvent(QEvent* event) override;
+    bool eventFilter(QObject* obj, QEvent* event) override;
     QSize sizeHint() const override;
 
 private:
-    QTextEdit* textEditor;
+    void updateArea(const QRect& rect, int dy);
+    void updateWidth();
+    void buildGlyphs();
+    int viewportOffset() const;
+
+    SourceEditor* textEditor;
+    FindingSnapshot findings;
+    const FindingIndex* index;
+    int fileId;
+    int digitCount;
+
+    // Pre-rendered digits, composed into line numbers when painting
+    QVector<QPixmap> digitGlyphs;
+    int digitWidth;
+    qreal glyphRatio;
 };
 
-#endif // LINE_NUMBER_AREA_HPP 
\ No newline at end of file
+#endif // LINE_NUMBER_AREA_HPP
@@ -6,21 +6,47 @@
 #include "file_tree_view.hpp"
 #include "cli_options_panel.hpp"
 #include "output_display.hpp"
+#include "finding_index.hpp"
+#include "editor_decorator.hpp"
+#include "emphasis_overlay.hpp"
+#include "search_engine.hpp"
+#include "find_bar.hpp"
+#include "project_search.hpp"
+#include "search_results_panel.hpp"
+#include "line_number_area.hpp"
+#include "large_file_view.hpp"
+#include "document_loader.hpp"
+#include "document_cache.hpp"
+#include "overview_ruler.hpp"
+#include "highlight_engine.hpp"
+#include "lexer_registry.hpp"
+#include "source_editor.hpp"
+#include "snippet_service.hpp"
 #include <QMainWindow>
 #include <QList>
 #include <QToolBar>
 #include <QAction>
 #include <QHBoxLayout>
 #include <QSplitter>
+#include <QStackedWidget>
+#include <QProgressBar>
+#include <QTabBar>
+#include <QPoint>
 #include <QTextEdit>
 #include <QFileSystemModel>
 #include <QKeyEvent>
+#include <QCloseEvent>
 #include <QVBoxLayout>
 #include <QTimer>
 #include <QPropertyAnimation>
 #include <QGraphicsOpacityEffect>
 #include <QLabel>
 #include <QFrame>
+#include <QHelpEvent>
+#include <QTextBlock>
+#include <QThreadPool>
+#include <QSharedPointer>
+#include <QAtomicInt>
 #include "syntax_highlighter.hpp"
 
 class MainWindow : public QMainWindow {
@@ -30,7 +56,7 @@ public:
     explicit MainWindow(QWidget* parent = nullptr);
     ~MainWindow();
     void show();
-    void updateAuditResults(const QList<AuditResult>& results);
+    void updateAuditResults(const FindingSnapshot& results);
     void setProjectRoot(const QString& path);
     
     // Widget management
@@ -40,10 +66,12 @@ public:
     void addWidget(QWidget* widget, Qt::Alignment alignment = Qt::Alignment());
 
     FileTreeView* getFileTreeView() const { return fileTree; }
-    QTextEdit* getTextEditor() const { return textEditor; }
+    SourceEditor* getTextEditor() const { return textEditor; }
+    LargeFileView* getLargeFileView() const { return largeFileView; }
     void highlightSecurityIssue(const AuditResult& result);
     void clearSecurityHighlights();
     void showSecurityNotification(const AuditResult& result);
+    static bool opensReadOnly(const QString& filePath);
 
 public slots:
     void toggleCliPanel();
@@ -51,10 +79,23 @@ public slots:
     void importFile(); 
     void toggleAutosave();
     void findNext();
+    void findNextMatch();
+    void findPreviousMatch();
+    void findInFiles();
+    bool openFile(const QString& filePath);
+    void nextFinding();
+    void previousFinding();
     void hideSecurityNotification();
 
+private slots:
+    void documentLoaded(const QString& filePath, QTextDocument* document, int longestLine, const Lexer* lexer);
+    void documentChanged();
+    void closeFileTab(int index);
+    void runAudit(const QString& options);
+
 protected:
     bool eventFilter(QObject* obj, QEvent* event) override;
+    void closeEvent(QCloseEvent* event) override;
 
 private:
     void setupUi();
@@ -64,6 +105,29 @@ private:
     void setupCentralWidget();
     void createSecurityNotificationWidget();
     void animateHighlight(const QTextCursor& cursor, const QString& severity);
+    void highlightFindings(const QVector<int>& rows);
+    void focusFinding(const QTextCursor& cursor, const AuditResult& result);
+    void goToFinding(int row);
+    void remapFindings();
+    void remapFinished(int id, const QString& filePath, const FindingSnapshot& findings, bool needsReaudit);
+    void reaudit();
+    bool showFindingToolTip(QHelpEvent* event);
+    void startSearch();
+    void selectMatch(int index);
+    void updateSearchStatus();
+    void startProjectSearch();
+    void openMatch(const QString& filePath, int line, int column);
+    void goToPosition(int line, int column);
+    void showDocument(const QString& filePath, QTextDocument* document);
+    void clearEditorView(bool closeLargeFile = true);
+    void storeViewState();
+    void selectFileTab(const QString& filePath);
+    void updateFileTab(const QString& filePath);
+    int fileTabIndex(const QString& filePath) const;
+    bool saveDocument(const QString& filePath, QTextDocument* document);
+    bool maybeSave(const QString& filePath, QTextDocument* document);
+    bool isLargeFile() const;
+    void findInLargeFile(bool backward);
 
     // Member variables in initialization order
     QSplitter* mainSplitter;
@@ -71,7 +135,7 @@ private:
     QWidget* centralWidget;
     QVBoxLayout* mainLayout;
     FileTreeView* fileTree;
-    QTextEdit* textEditor;
+    SourceEditor* textEditor;
     QFileSystemModel* fileSystemModel;
     CliOptionsPanel* cliPanel;
     OutputDisplay* outputDisplay;
@@ -82,7 +146,9 @@ private:
     bool autosaveEnabled;
     QString currentFilePath;
     QList<UIComponent*> uiComponents;
-    CppHighlighter* syntaxHighlighter;
+    FindingSnapshot analysedResults;
+    FindingSnapshot auditResults;
+    FindingIndex findingIndex;
     
     // Enhanced highlighting members
     QFrame* securityNotificationFrame;
@@ -91,9 +157,32 @@ private:
     QTimer* notificationTimer;
     QPropertyAnimation* notificationAnimation;
     QGraphicsOpacityEffect* notificationOpacity;
-    QList<QTextEdit::ExtraSelection> currentHighlights;
-    QTimer* blinkTimer;
-    bool blinkState;
+    QTimer* remapTimer;
+    QTimer* reauditTimer;
+    QSharedPointer<QAtomicInt> remapGeneration;
+    QThreadPool remapPool;
+    QString lastAuditOptions;
+    bool reauditPending;
+    EditorDecorator* decorator;
+    EmphasisOverlay* emphasisOverlay;
+    FindBar* findBar;
+    SearchEngine* searchEngine;
+    QTimer* searchTimer;
+    int searchOrigin;
+    bool jumpToMatch;
+    ProjectSearch* projectSearch;
+    SearchResultsPanel* searchResultsPanel;
+    LineNumberArea* lineNumberArea;
+    QStackedWidget* editorStack;
+    LargeFileView* largeFileView;
+    DocumentLoader* documentLoader;
+    QProgressBar* loadProgress;
+    QPoint pendingPosition;
+    DocumentCache* documentCache;
+    QTextDocument* emptyDocument;
+    QTabBar* fileTabs;
+    OverviewRuler* overviewRuler;
+    HighlightEngine* highlightEngine;
 };
 
 #endif // MAIN_WINDOW_HPP
\ No newline at end of file
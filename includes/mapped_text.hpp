@@ -0,0 +1,44 @@
+#pragma once
+
+#include "audit_result.hpp"
+#include <QFile>
+#include <QString>
+#include <QVector>
+
+class MappedText {
+public:
+    MappedText();
+    ~MappedText();
+
+    bool open(const QString& path);
+    void close();
+    bool isOpen() const { return file.isOpen(); }
+    QString errorString() const { return file.errorString(); }
+
+    const char* data() const { return begin; }
+    qint64 byteCount() const { return size; }
+    int lineCount() const { return lineStarts.size(); }
+    int longestLine() const { return maxLineLength; }
+    qint64 lineStart(int line) const { return lineStarts[line]; }
+    qint64 lineLength(int line) const;
+    int lineAt(qint64 offset) const;
+    QString lineText(int line, int maxBytes = -1) const;
+    QString lineText(int line, qint64 offset, int maxBytes) const;
+    qint64 columnOffset(int line, int column, AuditResult::ColumnKind kind) const;
+
+    static int characterSize(char lead);
+    static void scanNewlines(const char* data, qint64 size, QVector<qint64>& lineStarts, bool vectorized = true);
+
+private:
+    MappedText(const MappedText&) = delete;
+    MappedText& operator=(const MappedText&) = delete;
+
+    QFile file;
+    const char* begin;
+    qint64 size;
+    QByteArray fallback;
+
+    // Byte offset of the start of every line
+    QVector<qint64> lineStarts;
+    int maxLineLength;
+};
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "finding_store.hpp"
+#include "finding_index.hpp"
+#include "source_editor.hpp"
+#include <QWidget>
+#include <QImage>
+#include <QVector>
+#include <QHash>
+
+class OverviewRuler : public QWidget {
+    Q_OBJECT
+
+public:
+    explicit OverviewRuler(SourceEditor* editor);
+
+    void attachDocument();
+    void setFindings(const FindingSnapshot& findings, const FindingIndex* index, int fileId);
+    void clearFindings();
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+    void mousePressEvent(QMouseEvent* event) override;
+    void mouseMoveEvent(QMouseEvent* event) override;
+    QSize sizeHint() const override;
+
+private:
+    struct Mark {
+        int line;
+        int endLine;
+        int severity;
+
+        bool operator<(const Mark& other) const;
+        bool operator==(const Mark& other) const;
+    };
+
+    // Ruler state of one document
+    struct Cache {
+        QVector<Mark> marks;
+        QVector<quint16> counts; // Marks per pixel row and severity
+        int lineCount = 0;
+        QImage image;
+    };
+
+    Cache& cache();
+    void updateMarks(QVector<Mark> marks);
+    void rebuild(Cache& cache);
+    void addMark(Cache& cache, const Mark& mark, int delta, QVector<bool>& dirtyRows);
+    void renderRow(Cache& cache, int row);
+    int rowForLine(const Cache& cache, int line) const;
+    void scrollToY(int y);
+
+    SourceEditor* textEditor;
+    QHash<const QObject*, Cache> caches;
+};
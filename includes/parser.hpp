@@ -2,14 +2,20 @@
 
 #include "audit_result.hpp"
 #include <QString>
+#include <QStringList>
 #include <QList>
 #include <QJsonObject>
 
 class Parser {
 public:
     QList<AuditResult> parse(const QString& output);
+    QList<AuditResult> parseFindings(const QString& output, bool& foundResults, QStringList* runTools = nullptr);
+    static AuditResult noIssuesResult();
     ~Parser();
 
 private:
-    void parseSarifDocument(const QJsonObject& sarifObj, QList<AuditResult>& results, bool& foundResults);
+    void parseSarifDocument(const QJsonObject& sarifObj, QList<AuditResult>& results, bool& foundResults,
+                            QStringList* runTools);
+    static quint64 computeFingerprint(const QJsonObject& resultObj, const QString& ruleId, const QString& fileName,
+                                      const QString& snippet, const QString& message, const QString& context);
 }; 
\ No newline at end of file
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "search_engine.hpp"
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QThreadPool>
+#include <QSharedPointer>
+
+struct FileMatch {
+    QString filePath;
+    int line;
+    int column;
+    int length;
+    QString preview;
+};
+
+class ProjectSearch : public QObject {
+    Q_OBJECT
+
+public:
+    struct State;
+
+    explicit ProjectSearch(QObject* parent = nullptr);
+    ~ProjectSearch();
+
+    void search(const QString& rootPath, const SearchEngine::Query& query);
+    void cancel();
+    bool isRunning() const { return running; }
+
+    static QStringList ignoredDirectories();
+
+signals:
+    void matchesFound(const QVector<FileMatch>& matches);
+    void finished(int filesSearched, int matchCount, const QString& error);
+
+private:
+    void deliver(int id, const QVector<FileMatch>& matches);
+    void finish(int id, int filesSearched, const QString& error);
+
+    QThreadPool pool;
+    QSharedPointer<State> state;
+    int generation;
+    int matchCount;
+    bool running;
+};
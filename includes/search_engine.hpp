@@ -0,0 +1,74 @@
+#pragma once
+
+#include <QObject>
+#include <QString>
+#include <QVector>
+#include <QPair>
+#include <QThreadPool>
+#include <QAtomicInt>
+#include <QSharedPointer>
+#include <QStringMatcher>
+#include <QRegularExpression>
+
+struct TextMatch {
+    int position;
+    int length;
+};
+
+class SearchEngine : public QObject {
+    Q_OBJECT
+
+public:
+    struct Query {
+        QString pattern;
+        bool caseSensitive = false;
+        bool regularExpression = false;
+    };
+
+    explicit SearchEngine(QObject* parent = nullptr);
+    ~SearchEngine();
+
+    void search(const QString& text, const Query& query);
+    void cancel();
+
+    bool isRunning() const { return running; }
+    const QString& errorString() const { return error; }
+    const QVector<TextMatch>& matches() const { return results; }
+    int matchCount() const { return results.size(); }
+    QPair<int, int> matchRange(int start, int end) const;
+    int nextMatch(int position) const;
+    int previousMatch(int position) const;
+
+signals:
+    void matchesChanged();
+    void finished(int count);
+
+private:
+    void addMatches(int generation, const QVector<TextMatch>& batch);
+    void finish(int generation, const QString& error);
+
+    QThreadPool pool;
+    QSharedPointer<QAtomicInt> generation;
+    bool running;
+    QVector<TextMatch> results;
+    QString error;
+};
+
+// Finds the matches of a query in texts, on any thread
+class TextMatcher {
+public:
+    explicit TextMatcher(const SearchEngine::Query& query);
+
+    bool isValid() const { return error.isEmpty(); }
+    const QString& errorString() const { return error; }
+    bool isLiteral() const { return !regularExpression; }
+    int indexIn(const QString& text, int from, int& length) const { return indexIn(text, from, text.size(), length); }
+    int indexIn(const QString& text, int from, int to, int& length) const;
+
+private:
+    bool regularExpression;
+    int patternLength;
+    QStringMatcher matcher;
+    QRegularExpression expression;
+    QString error;
+};
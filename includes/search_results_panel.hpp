@@ -0,0 +1,37 @@
+#pragma once
+
+#include "project_search.hpp"
+#include <QWidget>
+#include <QLineEdit>
+#include <QCheckBox>
+#include <QLabel>
+#include <QTreeWidget>
+#include <QHash>
+
+class SearchResultsPanel : public QWidget {
+    Q_OBJECT
+
+public:
+    explicit SearchResultsPanel(QWidget* parent = nullptr);
+    SearchEngine::Query query() const;
+    void activate();
+    void startResults(const QString& rootPath);
+    void addMatches(const QVector<FileMatch>& matches);
+    void setStatus(const QString& status);
+
+signals:
+    void searchRequested();
+    void matchActivated(const QString& filePath, int line, int column);
+
+private:
+    QLabel* titleLabel;
+    QLineEdit* searchEdit;
+    QCheckBox* caseCheckBox;
+    QCheckBox* regexCheckBox;
+    QTreeWidget* resultsTree;
+    QLabel* statusLabel;
+    QString rootPath;
+    QHash<QString, QTreeWidgetItem*> fileItems;
+
+    void setupUi();
+};
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "mapped_text.hpp"
+#include <QString>
+#include <QStringList>
+#include <QDateTime>
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QSharedPointer>
+
+class SnippetService {
+public:
+    // Consecutive source lines around a finding
+    struct Snippet {
+        int firstLine = 0; // 1-based, 0 if the source is not available
+        int focusLine = 0; // The line of the finding
+        QStringList lines;
+
+        bool isEmpty() const { return lines.isEmpty(); }
+    };
+
+    static SnippetService& instance();
+
+    void setSourceRoot(const QString& path);
+    Snippet snippet(const QString& path, int line, int endLine = 0, int contextLines = 0);
+    QString lineText(const QString& path, int line);
+    void invalidate(const QString& path);
+
+private:
+    struct Entry {
+        QSharedPointer<MappedText> text;
+        QDateTime modified;
+        qint64 size = 0;
+    };
+
+    SnippetService() = default;
+    QSharedPointer<MappedText> open(const QString& path);
+    QString resolve(const QString& path) const;
+
+    QMutex mutex;
+    QString sourceRoot;
+    QHash<QString, Entry> entries;
+    QList<QString> recent; // Least recently used first
+};
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <QPlainTextEdit>
+#include <QTextDocument>
+#include <QTextBlock>
+#include <QRectF>
+
+class SourceEditor : public QPlainTextEdit {
+    Q_OBJECT
+
+public:
+    explicit SourceEditor(QWidget* parent = nullptr);
+
+    static void prepareDocument(QTextDocument* document);
+
+    QTextBlock firstVisibleBlock() const { return QPlainTextEdit::firstVisibleBlock(); }
+    QRectF blockGeometry(const QTextBlock& block) const;
+    void centerOnBlock(const QTextBlock& block);
+    void setLongLineMode(bool enabled);
+};
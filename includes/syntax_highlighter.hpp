@@ -3,7 +3,7 @@
 
 #include <QSyntaxHighlighter>
 #include <QTextCharFormat>
-#include <QRegularExpression>
+#include "lexer.hpp"
 
 class SyntaxHighlighter : public QSyntaxHighlighter {
     Q_OBJECT
@@ -12,33 +12,10 @@ public:
     explicit SyntaxHighlighter(QTextDocument* parent = nullptr);
     virtual ~SyntaxHighlighter() = default;
 
-protected:
-    void highlightBlock(const QString& text) override = 0;
-};
-
-class CppHighlighter : public SyntaxHighlighter {
-    Q_OBJECT
-
-public:
-    explicit CppHighlighter(QTextDocument* parent = nullptr);
+    static QTextCharFormat tokenFormat(Lexer::TokenKind kind);
 
 protected:
-    void highlightBlock(const QString& text) override;
-
-private:
-    struct HighlightingRule {
-        QRegularExpression pattern;
-        QTextCharFormat format;
-    };
-
-    QVector<HighlightingRule> highlightingRules;
-
-    QTextCharFormat keywordFormat;
-    QTextCharFormat functionFormat;
-    QTextCharFormat typeFormat;
-    QTextCharFormat commentFormat;
-    QTextCharFormat stringFormat;
-    QTextCharFormat numberFormat;
+    void highlightBlock(const QString& text) override = 0;
 };
 
 #endif // SYNTAX_HIGHLIGHTER_HPP 
\ No newline at end of file
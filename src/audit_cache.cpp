@@ -1,24 +1,86 @@
 #include "../includes/audit_cache.hpp"
 
 /**
- * @brief Retrieves cached audit results for a given file and options combination.
- * @param cacheKey The combined file path and options string.
- * @return A list of cached audit results, or an empty list if no results are found.
+ * @brief Checks whether results are cached for a file and analysis run.
+ * @param file The audited file path.
+ * @param runKey The canonical options of a single-tool run (see AuditOptions::cacheKey()).
+ * @return True if results for this run are cached, even if the run found nothing.
  */
-QList<AuditResult> AuditCache::getCachedResults(const QString& cacheKey) {
-    return cache.value(cacheKey);
+bool AuditCache::hasCachedResults(const QString& file, const QString& runKey) const {
+    auto it = cache.constFind(file);
+    return it != cache.constEnd() && it->contains(runKey);
 }
 
 /**
- * @brief Caches the audit results for a specified file and options combination.
+ * @brief Retrieves cached audit results for a given file and analysis run.
+ * @param file The audited file path.
+ * @param runKey The canonical options of a single-tool run.
+ * @return The shared snapshot of cached results, or an empty snapshot if no results are found.
+ */
+FindingSnapshot AuditCache::getCachedResults(const QString& file, const QString& runKey) const {
+    auto it = cache.constFind(file);
+    if (it == cache.constEnd() || !it->contains(runKey)) {
+        return FindingStore::empty();
+    }
+    return it->value(runKey);
+}
+
+/**
+ * @brief Caches the audit results for a specified file and analysis run.
  *
- * This function stores the provided list of audit results associated with
- * the given cache key (file path + options) in the cache. If the key already exists
- * in the cache, its associated results will be overwritten.
+ * Results are stored per analysis tool rather than per option string, so any
+ * combination of tools can later be assembled from the individual runs. If the
+ * run is already cached, its associated results will be overwritten.
  *
- * @param cacheKey The combined file path and options string.
- * @param results A QList of AuditResult objects representing the audit results to be cached.
+ * @param file The audited file path.
+ * @param runKey The canonical options of a single-tool run.
+ * @param results The snapshot of audit results to be cached; it is shared, not copied.
  */
-void AuditCache::cacheResults(const QString& cacheKey, const QList<AuditResult>& results) {
-    cache[cacheKey] = results;
-} 
\ No newline at end of file
+void AuditCache::cacheResults(const QString& file, const QString& runKey, const FindingSnapshot& results) {
+    cache[file][runKey] = results;
+}
+
+/**
+ * @brief Lists the runs cached for a file.
+ * @param file The audited file path.
+ * @return The run keys, in canonical order.
+ */
+QStringList AuditCache::getRunKeys(const QString& file) const {
+    return cache.value(file).keys();
+}
+
+/**
+ * @brief Checks whether the analysed content of a file is known.
+ * @param file The audited file path.
+ * @return True if the content ctrace analysed was recorded.
+ */
+bool AuditCache::hasAnalysedContent(const QString& file) const {
+    return analysedContent.contains(file);
+}
+
+/**
+ * @brief Retrieves the content of a file as ctrace analysed it.
+ * @param file The audited file path.
+ * @return The analysed lines, or an empty list if unknown.
+ */
+QStringList AuditCache::getAnalysedContent(const QString& file) const {
+    return analysedContent.value(file);
+}
+
+/**
+ * @brief Records the content the cached runs of a file refer to.
+ * @param file The audited file path.
+ * @param lines The lines of the file as ctrace analysed it.
+ */
+void AuditCache::setAnalysedContent(const QString& file, const QStringList& lines) {
+    analysedContent[file] = lines;
+}
+
+/**
+ * @brief Drops every cached run of the given file.
+ * @param file The audited file path.
+ */
+void AuditCache::invalidate(const QString& file) {
+    cache.remove(file);
+    analysedContent.remove(file);
+}
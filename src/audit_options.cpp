@@ -0,0 +1,198 @@
+#include "../includes/audit_options.hpp"
+
+/**
+ * @class AuditOptions
+ * @brief Canonical representation of a set of ctrace command-line options.
+ *
+ * The options panel produces flags in whatever order the user ticked them,
+ * so two equivalent requests may differ textually. AuditOptions keeps the
+ * analysis tools as a sorted, duplicate-free set and renders them in a fixed
+ * order, which makes the option string usable as a cache key and lets a
+ * request be split into one run per analysis tool.
+ */
+
+/**
+ * @brief Constructs an empty option set.
+ */
+AuditOptions::AuditOptions() : verbosity(0) {}
+
+/**
+ * @brief Returns the analysis tools understood by ctrace, in canonical order.
+ * @return The list of tool names (without the leading "--").
+ */
+QStringList AuditOptions::knownTools() {
+    return QStringList() << "dynamic" << "static" << "symbolic";
+}
+
+/**
+ * @brief Parses a ctrace option string into its canonical form.
+ *
+ * Analysis flags ("--static", "--symbolic", ...) become tools, "--all" expands
+ * to every known tool and "--verbose N" sets the verbosity. Any other argument
+ * is preserved verbatim since it may change what the analysis reports.
+ *
+ * @param options The option string, e.g. "--symbolic --static --verbose 2".
+ * @return The parsed options.
+ */
+AuditOptions AuditOptions::fromString(const QString& options) {
+    AuditOptions result;
+    QStringList arguments = options.split(' ', Qt::SkipEmptyParts);
+
+    for (int i = 0; i < arguments.size(); ++i) {
+        const QString& argument = arguments[i];
+
+        if (argument == "--all") {
+            for (const QString& tool : knownTools()) {
+                result.addTool(tool);
+            }
+        } else if (argument == "--verbose") {
+            bool ok = false;
+            int level = i + 1 < arguments.size() ? arguments[i + 1].toInt(&ok) : 0;
+            if (ok) {
+                ++i;
+            } else {
+                level = 1;
+            }
+            result.setVerbosity(level);
+        } else if (argument.startsWith("--") && knownTools().contains(argument.mid(2))) {
+            result.addTool(argument.mid(2));
+        } else {
+            result.extraArguments.append(argument);
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief Adds an analysis tool to the set, keeping it sorted and unique.
+ * @param tool The tool name (without the leading "--").
+ */
+void AuditOptions::addTool(const QString& tool) {
+    if (tool.isEmpty() || tools.contains(tool)) {
+        return;
+    }
+    tools.append(tool);
+    tools.sort();
+}
+
+/**
+ * @brief Sets the verbosity level passed to ctrace.
+ * @param level The verbosity level, 0 disables verbose output.
+ */
+void AuditOptions::setVerbosity(int level) {
+    verbosity = qMax(0, level);
+}
+
+/**
+ * @brief Checks whether the given analysis tool is part of the set.
+ * @param tool The tool name (without the leading "--").
+ * @return True if the tool is requested.
+ */
+bool AuditOptions::hasTool(const QString& tool) const {
+    return tools.contains(tool);
+}
+
+/**
+ * @brief Checks whether no analysis tool was requested.
+ * @return True if the tool set is empty.
+ */
+bool AuditOptions::isEmpty() const {
+    return tools.isEmpty();
+}
+
+/**
+ * @brief Splits the request into one option set per analysis tool.
+ *
+ * Each part keeps the verbosity and extra arguments of the original request.
+ * A request without any tool is returned unchanged as a single part.
+ *
+ * @return The per-tool option sets, in canonical order.
+ */
+QList<AuditOptions> AuditOptions::splitByTool() const {
+    QList<AuditOptions> parts;
+    if (tools.isEmpty()) {
+        parts.append(*this);
+        return parts;
+    }
+
+    for (const QString& tool : tools) {
+        AuditOptions part(*this);
+        part.tools = QStringList(tool);
+        parts.append(part);
+    }
+    return parts;
+}
+
+/**
+ * @brief Returns these options restricted to the given analysis tools.
+ *
+ * The verbosity and extra arguments are kept, so the missing tools of a
+ * request can be run together by a single ctrace invocation.
+ *
+ * @param subset The tool names (without the leading "--").
+ * @return The option set with only those tools.
+ */
+AuditOptions AuditOptions::withTools(const QStringList& subset) const {
+    AuditOptions part(*this);
+    part.tools.clear();
+    for (const QString& tool : subset) {
+        part.addTool(tool);
+    }
+    return part;
+}
+
+/**
+ * @brief Finds which requested tool produced a SARIF run.
+ *
+ * ctrace reports one run per analyzer, named by its driver. When a single
+ * tool was run every run belongs to it; otherwise the driver name has to
+ * mention the tool, e.g. "ctrace-static".
+ *
+ * @param driverName The SARIF tool.driver.name of the run.
+ * @param tools The tools of the ctrace invocation.
+ * @return The tool, or an empty string if the run cannot be attributed.
+ */
+QString AuditOptions::toolOfRun(const QString& driverName, const QStringList& tools) {
+    if (tools.size() == 1) {
+        return tools.first();
+    }
+    for (const QString& tool : tools) {
+        if (driverName.contains(tool, Qt::CaseInsensitive)) {
+            return tool;
+        }
+    }
+    return QString();
+}
+
+/**
+ * @brief Builds the key identifying the findings produced by these options.
+ *
+ * Verbosity only affects the amount of log output, not the findings, so it
+ * is left out of the key.
+ *
+ * @return The canonical cache key.
+ */
+QString AuditOptions::cacheKey() const {
+    QStringList parts;
+    for (const QString& tool : tools) {
+        parts << "--" + tool;
+    }
+    parts << extraArguments;
+    return parts.join(" ");
+}
+
+/**
+ * @brief Renders the options as a canonical ctrace command line.
+ * @return The option string, e.g. "--static --symbolic --verbose 2".
+ */
+QString AuditOptions::toString() const {
+    QString options = cacheKey();
+    if (verbosity > 0) {
+        if (!options.isEmpty()) {
+            options += " ";
+        }
+        options += QString("--verbose %1").arg(verbosity);
+    }
+    return options;
+}
@@ -14,7 +14,7 @@
  * 
  * @param fileName The name of the file being audited.
  */
-AuditResult::AuditResult(const QString& fileName) : fileName(fileName), line(0), column(0), endLine(0), endColumn(0) {}
+AuditResult::AuditResult(const QString& fileName) : fileName(fileName), line(0), column(0), endLine(0), endColumn(0), columnKind(Utf16CodeUnits), fingerprint(0) {}
 
 /**
  * @brief Adds an issue to the audit result.
@@ -63,6 +63,15 @@ void AuditResult::setEndColumn(int endColumnNumber) {
     endColumn = endColumnNumber;
 }
 
+/**
+ * @brief Sets the unit the columns of this audit result count.
+ * 
+ * @param kind The column unit.
+ */
+void AuditResult::setColumnKind(ColumnKind kind) {
+    columnKind = kind;
+}
+
 /**
  * @brief Sets the file path for this audit result.
  * 
@@ -81,6 +90,58 @@ void AuditResult::setRuleId(const QString& id) {
     ruleId = id;
 }
 
+/**
+ * @brief Sets the name of the analysis tool that reported this result.
+ * 
+ * @param name The SARIF driver name of the reporting tool.
+ */
+void AuditResult::setToolName(const QString& name) {
+    toolName = name;
+}
+
+/**
+ * @brief Sets the SARIF level reported for this result.
+ * 
+ * @param sarifLevel The SARIF level ("error", "warning", "note", ...).
+ */
+void AuditResult::setLevel(const QString& sarifLevel) {
+    level = sarifLevel;
+}
+
+/**
+ * @brief Sets the stable fingerprint identifying this finding across runs.
+ * 
+ * @param value The fingerprint, 0 if the result has no identity.
+ */
+void AuditResult::setFingerprint(quint64 value) {
+    fingerprint = value;
+}
+
+/**
+ * @brief Determines the severity of this result.
+ * 
+ * The SARIF level is used when the tool reported one. Otherwise the severity
+ * is guessed from the rule ID and message, as the editor always did.
+ * 
+ * @return The severity of the result.
+ */
+AuditResult::Severity AuditResult::getSeverity() const {
+    if (level == "error") return Error;
+    if (level == "warning") return Warning;
+    if (level == "note" || level == "info" || level == "none") return Info;
+
+    if (ruleId.contains("error", Qt::CaseInsensitive) ||
+        message.contains("error", Qt::CaseInsensitive)) {
+        return Error;
+    }
+    if (ruleId.contains("warning", Qt::CaseInsensitive) ||
+        message.contains("warning", Qt::CaseInsensitive) ||
+        message.contains("CWE", Qt::CaseInsensitive)) {
+        return Warning;
+    }
+    return Info;
+}
+
 /**
  * @brief Generates a summary of the audit result.
  * 
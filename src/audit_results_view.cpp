@@ -1,4 +1,5 @@
 #include "../includes/audit_results_view.hpp"
+#include "../includes/snippet_service.hpp"
 #include <QVBoxLayout>
 #include <QLabel>
 #include <QScrollArea>
@@ -8,7 +9,8 @@
  * @brief A widget for displaying audit results.
  * 
  * The AuditResultsView class provides a scrollable view to display
- * audit results, including file summaries and detailed issues.
+ * audit results, including file summaries, detailed issues and the line of
+ * code of each finding, read through the SnippetService.
  */
 
 /**
@@ -18,7 +20,7 @@
  * 
  * @param parent The parent widget (default is nullptr).
  */
-AuditResultsView::AuditResultsView(QWidget* parent) : QWidget(parent) {
+AuditResultsView::AuditResultsView(QWidget* parent) : QWidget(parent), currentResults(FindingStore::empty()) {
     QVBoxLayout* layout = new QVBoxLayout(this);
     setLayout(layout);
 }
@@ -40,14 +42,24 @@ void AuditResultsView::render() {
     }
 
     // Create new widgets for each result
-    for (const AuditResult& result : currentResults) {
-        QLabel* summaryLabel = new QLabel(result.getSummary(), this);
+    for (int row = 0; row < currentResults->size(); ++row) {
+        QLabel* summaryLabel = new QLabel(currentResults->summary(row), this);
         layout->addWidget(summaryLabel);
 
-        for (const QString& issue : result.getIssues()) {
+        for (const QString& issue : currentResults->issues(row)) {
             QLabel* issueLabel = new QLabel("  • " + issue, this);
             layout->addWidget(issueLabel);
         }
+
+        // The code is read from the source when the finding is displayed
+        if (currentResults->hasLocationInfo(row)) {
+            QString code = SnippetService::instance().lineText(currentResults->filePath(row), currentResults->line(row));
+            if (!code.trimmed().isEmpty()) {
+                QLabel* codeLabel = new QLabel("  • 💻 Code: " + code.trimmed(), this);
+                codeLabel->setTextFormat(Qt::PlainText);
+                layout->addWidget(codeLabel);
+            }
+        }
     }
 }
 
@@ -55,11 +67,11 @@ void AuditResultsView::render() {
  * @brief Displays a list of audit results.
  * 
  * Updates the view with the provided audit results and triggers
- * a re-render to display the new data.
+ * a re-render to display the new data. The snapshot is shared, not copied.
  * 
- * @param results A list of AuditResult objects to display.
+ * @param results The snapshot of audit results to display.
  */
-void AuditResultsView::displayResults(const QList<AuditResult>& results) {
+void AuditResultsView::displayResults(const FindingSnapshot& results) {
     currentResults = results;
     render();
 }
\ No newline at end of file
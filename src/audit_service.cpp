@@ -1,11 +1,14 @@
 #include "../includes/audit_service.hpp"
+#include "../includes/finding_remapper.hpp"
+#include <QFile>
+#include <QVector>
 
 /**
  * @class AuditService
  * @brief Provides functionality to perform audits on files.
  * 
  * The AuditService class interacts with the ctrace CLI to perform audits,
- * parses the results, caches them, and highlights errors in the files.
+ * parses the results and caches them.
  */
 
 /**
@@ -16,40 +19,179 @@ AuditService::AuditService() {}
 /**
  * @brief Performs an audit on the specified file and returns the results.
  *
- * This method first checks the cache for any previously computed audit results
- * for the given file. If cached results are found, they are returned immediately.
- * Otherwise, the method executes the `ctrace` CLI tool to perform the audit,
- * parses the results, caches them for future use, and highlights any errors
- * in the file.
+ * The requested options are reduced to a canonical set and split into one
+ * run per analysis tool. Runs already present in the cache are reused, so
+ * "--symbolic --static" and a later "--static" alone share the same work.
+ * All the missing tools are executed together by a single `ctrace`
+ * invocation; its SARIF runs are then attributed to their tool by driver name
+ * and cached per tool. Runs that cannot be attributed are still reported but
+ * not cached, and a tool without any run is retried next time. The findings
+ * of all runs are then concatenated; a single run is returned as the very
+ * snapshot held by the cache. If the file changed since the cached runs were
+ * analysed, they are first moved along with the edits, or dropped when code
+ * actually changed.
  *
  * @param file The path to the file to be audited.
  * @param options The options to be used with the ctrace CLI.
- * @return A QList of AuditResult objects containing the audit results.
+ * @return A shared snapshot of the audit results.
  */
-QList<AuditResult> AuditService::performAudit(const QString& file, const QString& options) {
-    // Create a cache key that includes both file and options
-    QString cacheKey = file + "|" + options;
+FindingSnapshot AuditService::performAudit(const QString& file, const QString& options) {
+    AuditOptions requested = AuditOptions::fromString(options);
+    QStringList content = readLines(file);
+    syncCache(file, content);
+    
+    QList<AuditOptions> parts = requested.splitByTool();
+    QList<FindingSnapshot> runs;
+    QList<int> missing;
+    QStringList missingTools;
+    bool foundResults = false;
     
     // Check cache first
-    QList<AuditResult> cachedResults = auditCache.getCachedResults(cacheKey);
-    if (!cachedResults.isEmpty()) {
-        return cachedResults;
+    for (int i = 0; i < parts.size(); ++i) {
+        QString runKey = parts[i].cacheKey();
+        if (auditCache.hasCachedResults(file, runKey)) {
+            runs.append(auditCache.getCachedResults(file, runKey));
+            foundResults = true;
+        } else {
+            runs.append(FindingSnapshot());
+            missing.append(i);
+            missingTools << parts[i].getTools();
+        }
     }
-
-    // Execute ctrace CLI with provided options
-    QString output = ctraceCLI.execute(file, options);
-    
-    // Parse results
-    QList<AuditResult> results = parser.parse(output);
     
-    // Cache results with the combined key
-    auditCache.cacheResults(cacheKey, results);
+    QList<AuditResult> unattributed;
+    if (!missing.isEmpty()) {
+        // Execute ctrace CLI once for all the missing tools
+        QString output = ctraceCLI.execute(file, requested.withTools(missingTools).toString());
+        
+        // Parse results, remembering which runs the report contains
+        bool runFoundResults = false;
+        QStringList reportedTools;
+        QList<AuditResult> results = parser.parseFindings(output, runFoundResults, &reportedTools);
+        
+        QVector<QList<AuditResult>> toolResults(missing.size());
+        QVector<bool> reported(missing.size(), false);
+        auto toolIndex = [&](const QString& driverName) {
+            return missing.size() == 1 ? 0 : missingTools.indexOf(AuditOptions::toolOfRun(driverName, missingTools));
+        };
+        for (const QString& driverName : reportedTools) {
+            int index = toolIndex(driverName);
+            if (index >= 0) {
+                reported[index] = true;
+            }
+        }
+        for (const AuditResult& result : results) {
+            int index = toolIndex(result.getToolName());
+            if (index >= 0) {
+                toolResults[index].append(result);
+            } else {
+                unattributed.append(result);
+            }
+        }
+        
+        for (int i = 0; i < missing.size(); ++i) {
+            FindingSnapshot runResults = FindingStore::fromResults(toolResults[i]);
+            
+            // Only cache tools that produced a SARIF run, failed runs are retried next time
+            if (reported[i]) {
+                auditCache.cacheResults(file, parts[missing[i]].cacheKey(), runResults);
+                auditCache.setAnalysedContent(file, content);
+            }
+            runs[missing[i]] = runResults;
+        }
+        foundResults = foundResults || runFoundResults;
+    }
     
-    //TODO
-    // Highlight errors in the file
-    //errorHighlighter.highlightErrors(file, results);
+    // If no security issues were found, show a success message
+    if (!foundResults) {
+        return FindingStore::fromResults(QList<AuditResult>() << Parser::noIssuesResult());
+    }
     
-    return results;
+    if (!unattributed.isEmpty()) {
+        runs.append(FindingStore::fromResults(unattributed));
+    }
+    return FindingStore::concat(runs);
+}
+
+/**
+ * @brief Returns the content of a file as it was last analysed.
+ * @param file The audited file path.
+ * @return The analysed lines, or an empty list if the file was never analysed.
+ */
+QStringList AuditService::analysedContent(const QString& file) const {
+    return auditCache.hasAnalysedContent(file) ? auditCache.getAnalysedContent(file) : QStringList();
+}
+
+/**
+ * @brief Moves findings along with the edits made to a file since it was analysed.
+ *
+ * Findings are shifted to their current line, dropped if their line was
+ * deleted and marked stale if their line was modified, so the editor stays
+ * accurate without waiting for a new analysis. This only diffs the given
+ * contents and may run on a worker thread.
+ *
+ * @param file The path of the edited file.
+ * @param findings The findings as reported by the last audit.
+ * @param analysedContent The lines of the file as it was analysed (see analysedContent()).
+ * @param currentContent The current content of the file.
+ * @param needsReaudit Set to true if code changed within the lines of a finding of the file.
+ * @return The relocated findings, or the unchanged findings if the file was never analysed.
+ */
+FindingSnapshot AuditService::remapFindings(const QString& file, const FindingSnapshot& findings,
+                                            const QStringList& analysedContent, const QString& currentContent,
+                                            bool& needsReaudit) {
+    needsReaudit = false;
+    if (analysedContent.isEmpty()) {
+        return findings;
+    }
+
+    FindingRemapper remapper(analysedContent, currentContent.split('\n'));
+    needsReaudit = remapper.changesFindings(findings, file);
+    return remapper.remap(findings, file);
+}
+
+/**
+ * @brief Brings the cached runs of a file up to date with its content.
+ *
+ * If only whitespace or blank lines changed, the cached findings are
+ * relocated and kept. Otherwise the cached runs are dropped so the next audit
+ * executes ctrace again.
+ *
+ * @param file The audited file path.
+ * @param content The current lines of the file.
+ */
+void AuditService::syncCache(const QString& file, const QStringList& content) {
+    if (!auditCache.hasAnalysedContent(file)) {
+        return;
+    }
+    QStringList analysed = auditCache.getAnalysedContent(file);
+    if (analysed == content) {
+        return;
+    }
+
+    FindingRemapper remapper(analysed, content);
+    if (remapper.hasCodeChanges()) {
+        auditCache.invalidate(file);
+        return;
+    }
+
+    for (const QString& runKey : auditCache.getRunKeys(file)) {
+        auditCache.cacheResults(file, runKey, remapper.remap(auditCache.getCachedResults(file, runKey), file));
+    }
+    auditCache.setAnalysedContent(file, content);
+}
+
+/**
+ * @brief Reads the lines of a file from disk.
+ * @param file The file path.
+ * @return The lines, or an empty list if the file cannot be read.
+ */
+QStringList AuditService::readLines(const QString& file) {
+    QFile source(file);
+    if (!source.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        return QStringList();
+    }
+    return QString::fromUtf8(source.readAll()).split('\n');
 }
 
 AuditService::~AuditService() {}
\ No newline at end of file
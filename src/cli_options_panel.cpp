@@ -109,21 +109,28 @@ void CliOptionsPanel::connectSignals()
 }
 
 /**
- * @brief Retrieves the command-line options based on the selected settings.
- * @return A string containing the command-line options.
+ * @brief Retrieves the selected analysis options as a canonical set.
+ * @return The selected options.
  */
-QString CliOptionsPanel::getCommandOptions() const
+AuditOptions CliOptionsPanel::getAuditOptions() const
 {
-    QStringList options;
+    AuditOptions options;
 
     // Only add individual options, never use --all
-    if (symbolicCheck->isChecked()) options << "--symbolic";
-    if (staticCheck->isChecked()) options << "--static";
-    if (dynamicCheck->isChecked()) options << "--dynamic";
+    if (symbolicCheck->isChecked()) options.addTool("symbolic");
+    if (staticCheck->isChecked()) options.addTool("static");
+    if (dynamicCheck->isChecked()) options.addTool("dynamic");
 
-    if (verboseSpin->value() > 0) {
-        options << "--verbose" << QString::number(verboseSpin->value());
-    }
+    options.setVerbosity(verboseSpin->value());
 
-    return options.join(" ");
+    return options;
+}
+
+/**
+ * @brief Retrieves the command-line options based on the selected settings.
+ * @return A string containing the command-line options, in canonical order.
+ */
+QString CliOptionsPanel::getCommandOptions() const
+{
+    return getAuditOptions().toString();
 }
\ No newline at end of file
@@ -0,0 +1,344 @@
+#include "../includes/cpp_lexer.hpp"
+#include <QMutex>
+#include <QMutexLocker>
+#include <QStringList>
+
+/**
+ * @class CppLexer
+ * @brief Line-by-line C/C++ tokenizer carrying its state across lines.
+ *
+ * Each line is scanned once, left to right, into comment, string, number,
+ * keyword, type, function and preprocessor tokens. Constructs spanning
+ * several lines (block comments, raw strings and macros continued with a
+ * backslash) are described by the integer state returned for the line and
+ * passed back in for the next one, as QSyntaxHighlighter block states are.
+ * Equal states mean equal lexer contexts, so a highlighter can stop as soon
+ * as a line ends in the same state as before. Keywords and types are looked
+ * up in a perfect hash table built at compile time: every word hashes to its
+ * own slot, so a lookup is one hash and at most one comparison. The lexer has
+ * no instance state and may be used from any thread.
+ */
+
+namespace {
+struct Word {
+    const char* text;
+    CppLexer::TokenKind kind;
+};
+
+// Words listed in both sets are types
+constexpr Word Words[] = {
+    {"bool", CppLexer::Type}, {"break", CppLexer::Keyword}, {"case", CppLexer::Keyword}, {"catch", CppLexer::Keyword},
+    {"char", CppLexer::Type}, {"class", CppLexer::Keyword}, {"const", CppLexer::Keyword}, {"continue", CppLexer::Keyword},
+    {"default", CppLexer::Keyword}, {"delete", CppLexer::Keyword}, {"deque", CppLexer::Type}, {"do", CppLexer::Keyword},
+    {"double", CppLexer::Type}, {"else", CppLexer::Keyword}, {"enum", CppLexer::Keyword}, {"explicit", CppLexer::Keyword},
+    {"false", CppLexer::Keyword}, {"float", CppLexer::Type}, {"for", CppLexer::Keyword}, {"friend", CppLexer::Keyword},
+    {"goto", CppLexer::Keyword}, {"if", CppLexer::Keyword}, {"inline", CppLexer::Keyword}, {"int", CppLexer::Type},
+    {"list", CppLexer::Type}, {"long", CppLexer::Type}, {"map", CppLexer::Type}, {"namespace", CppLexer::Keyword},
+    {"new", CppLexer::Keyword}, {"nullptr", CppLexer::Keyword}, {"operator", CppLexer::Keyword}, {"priority_queue", CppLexer::Type},
+    {"private", CppLexer::Keyword}, {"protected", CppLexer::Keyword}, {"public", CppLexer::Keyword}, {"queue", CppLexer::Type},
+    {"return", CppLexer::Keyword}, {"set", CppLexer::Type}, {"short", CppLexer::Type}, {"signals", CppLexer::Keyword},
+    {"signed", CppLexer::Keyword}, {"slots", CppLexer::Keyword}, {"stack", CppLexer::Type}, {"static", CppLexer::Keyword},
+    {"string", CppLexer::Type}, {"struct", CppLexer::Keyword}, {"switch", CppLexer::Keyword}, {"template", CppLexer::Keyword},
+    {"this", CppLexer::Keyword}, {"throw", CppLexer::Keyword}, {"true", CppLexer::Keyword}, {"try", CppLexer::Keyword},
+    {"typedef", CppLexer::Keyword}, {"typename", CppLexer::Keyword}, {"union", CppLexer::Keyword}, {"unsigned", CppLexer::Keyword},
+    {"vector", CppLexer::Type}, {"virtual", CppLexer::Keyword}, {"void", CppLexer::Type}, {"volatile", CppLexer::Keyword},
+    {"while", CppLexer::Keyword}
+};
+
+constexpr int WordCount = sizeof(Words) / sizeof(Words[0]);
+constexpr int TableSize = 256;
+constexpr int MinWordLength = 2;
+constexpr int MaxWordLength = 14;
+
+constexpr int textLength(const char* text) {
+    int length = 0;
+    while (text[length]) {
+        ++length;
+    }
+    return length;
+}
+
+// Coefficients found by search so that no two words share a slot
+constexpr unsigned wordHash(unsigned first, unsigned second, unsigned last, unsigned length) {
+    return (first * 4 + second * 30 + last * 33 + length) & (TableSize - 1);
+}
+
+struct WordTable {
+    int slots[TableSize];
+    bool perfect;
+};
+
+constexpr WordTable buildWordTable() {
+    WordTable table{};
+    table.perfect = true;
+    for (int i = 0; i < TableSize; ++i) {
+        table.slots[i] = -1;
+    }
+    for (int i = 0; i < WordCount; ++i) {
+        const char* text = Words[i].text;
+        int length = textLength(text);
+        unsigned slot = wordHash(text[0], text[1], text[length - 1], length);
+        if (table.slots[slot] >= 0 || length < MinWordLength || length > MaxWordLength) {
+            table.perfect = false;
+        }
+        table.slots[slot] = i;
+    }
+    return table;
+}
+
+constexpr WordTable WordSlots = buildWordTable();
+static_assert(WordSlots.perfect, "Keyword hash collision: choose new wordHash() coefficients");
+
+inline bool isIdentifierStart(QChar c) {
+    return c.isLetter() || c == QLatin1Char('_');
+}
+
+inline bool isIdentifierPart(QChar c) {
+    return c.isLetterOrNumber() || c == QLatin1Char('_');
+}
+
+// Layout of a line state
+const int ModeMask = 0x3;
+const int CodeMode = 0;
+const int CommentMode = 1;
+const int RawStringMode = 2;
+const int MacroFlag = 0x4;
+const int DelimiterShift = 8;
+const int MaxDelimiterLength = 16;
+
+bool isRawStringPrefix(const QStringRef& word) {
+    return word == QLatin1String("R") || word == QLatin1String("LR") || word == QLatin1String("uR") ||
+           word == QLatin1String("UR") || word == QLatin1String("u8R");
+}
+
+bool isValidDelimiter(const QString& delimiter) {
+    for (QChar c : delimiter) {
+        if (c.isSpace() || c == QLatin1Char('"') || c == QLatin1Char('\\') || c == QLatin1Char(')')) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Raw string delimiters, referenced by index from line states
+QMutex delimiterMutex;
+QStringList delimiters;
+}
+
+/**
+ * @brief Tokenizes one line.
+ *
+ * Tokens are appended in order. A macro line is covered by one preprocessor
+ * token first, and the comments and strings inside it follow as separate
+ * tokens to be applied on top.
+ *
+ * @param text The text of the line, without its line break.
+ * @param state The state returned for the previous line, or a negative value for the first line.
+ * @param tokens Receives the tokens of the line.
+ * @return The state at the end of the line.
+ */
+int CppLexer::tokenizeLine(const QString& text, int state, QVector<Token>& tokens) const {
+    const QChar* data = text.constData();
+    const int length = text.length();
+    if (state < 0) {
+        state = 0;
+    }
+    int mode = state & ModeMask;
+    bool macro = state & MacroFlag;
+    int i = 0;
+
+    // Continue a construct left open by the previous line
+    if (mode == CommentMode) {
+        int end = text.indexOf(QLatin1String("*/"));
+        if (end < 0) {
+            tokens.append(Token{0, length, Comment});
+            return state;
+        }
+        i = end + 2;
+        tokens.append(Token{0, i, Comment});
+        mode = CodeMode;
+    } else if (mode == RawStringMode) {
+        QString terminator = QLatin1Char(')') + delimiter(state >> DelimiterShift) + QLatin1Char('"');
+        int end = text.indexOf(terminator);
+        if (end < 0) {
+            tokens.append(Token{0, length, String});
+            return state;
+        }
+        i = end + terminator.length();
+        tokens.append(Token{0, i, String});
+        mode = CodeMode;
+    }
+
+    // A line starting with '#' opens a preprocessor directive
+    if (!macro) {
+        int first = i;
+        while (first < length && data[first].isSpace()) {
+            ++first;
+        }
+        if (first < length && data[first] == QLatin1Char('#')) {
+            macro = true;
+            tokens.append(Token{first, length - first, Preprocessor});
+
+            // Header name of an #include
+            int word = first + 1;
+            while (word < length && data[word].isSpace()) {
+                ++word;
+            }
+            int next = word;
+            while (next < length && isIdentifierPart(data[next])) {
+                ++next;
+            }
+            if (text.midRef(word, next - word).startsWith(QLatin1String("include"))) {
+                while (next < length && data[next].isSpace()) {
+                    ++next;
+                }
+                int close = next < length && data[next] == QLatin1Char('<') ? text.indexOf(QLatin1Char('>'), next) : -1;
+                if (close > 0) {
+                    tokens.append(Token{next, close + 1 - next, String});
+                    i = close + 1;
+                }
+            }
+        }
+    } else if (i < length) {
+        tokens.append(Token{i, length - i, Preprocessor});
+    }
+
+    while (i < length) {
+        const QChar c = data[i];
+        const int start = i;
+
+        if (c == QLatin1Char('/') && i + 1 < length && data[i + 1] == QLatin1Char('/')) {
+            tokens.append(Token{start, length - start, Comment});
+            i = length;
+            break;
+        }
+
+        if (c == QLatin1Char('/') && i + 1 < length && data[i + 1] == QLatin1Char('*')) {
+            int end = text.indexOf(QLatin1String("*/"), i + 2);
+            if (end < 0) {
+                tokens.append(Token{start, length - start, Comment});
+                mode = CommentMode;
+                break;
+            }
+            i = end + 2;
+            tokens.append(Token{start, i - start, Comment});
+        } else if (c == QLatin1Char('"') || c == QLatin1Char('\'')) {
+            // String or character literal, up to the matching unescaped quote
+            for (++i; i < length && data[i] != c; ++i) {
+                if (data[i] == QLatin1Char('\\')) {
+                    ++i;
+                }
+            }
+            i = qMin(i + 1, length);
+            tokens.append(Token{start, i - start, String});
+        } else if (c.isDigit()) {
+            // Numbers with their suffixes, hexadecimal digits, separators and exponents
+            for (++i; i < length && (isIdentifierPart(data[i]) || data[i] == QLatin1Char('.') ||
+                                      data[i] == QLatin1Char('\'')); ++i) {}
+            tokens.append(Token{start, i - start, Number});
+        } else if (isIdentifierStart(c)) {
+            for (++i; i < length && isIdentifierPart(data[i]); ++i) {}
+
+            if (i < length && data[i] == QLatin1Char('"') && isRawStringPrefix(text.midRef(start, i - start))) {
+                // Raw string: R"delimiter( ... )delimiter"
+                int open = text.indexOf(QLatin1Char('('), i + 1);
+                QString rawDelimiter = open > 0 ? text.mid(i + 1, open - i - 1) : QString();
+                if (open > 0 && rawDelimiter.length() <= MaxDelimiterLength && isValidDelimiter(rawDelimiter)) {
+                    QString terminator = QLatin1Char(')') + rawDelimiter + QLatin1Char('"');
+                    int end = text.indexOf(terminator, open + 1);
+                    if (end < 0) {
+                        tokens.append(Token{start, length - start, String});
+                        return RawStringMode | (macro ? MacroFlag : 0) |
+                               (internDelimiter(rawDelimiter) << DelimiterShift);
+                    }
+                    i = end + terminator.length();
+                    tokens.append(Token{start, i - start, String});
+                    continue;
+                }
+            }
+            if (macro) {
+                continue; // Keeps the preprocessor format
+            }
+
+            bool found = false;
+            TokenKind kind = wordKind(data + start, i - start, found);
+            if (found) {
+                tokens.append(Token{start, i - start, kind});
+            } else {
+                int next = i;
+                while (next < length && data[next].isSpace()) {
+                    ++next;
+                }
+                if (next < length && data[next] == QLatin1Char('(')) {
+                    tokens.append(Token{start, i - start, Function});
+                }
+            }
+        } else {
+            ++i;
+        }
+    }
+
+    // A directive continues on the next line after a trailing backslash or inside a comment
+    if (macro && mode == CodeMode) {
+        int last = length - 1;
+        while (last >= 0 && data[last].isSpace()) {
+            --last;
+        }
+        macro = last >= 0 && data[last] == QLatin1Char('\\');
+    }
+    return mode | (macro ? MacroFlag : 0);
+}
+
+/**
+ * @brief Looks up a keyword or type.
+ * @param word The first character of the identifier.
+ * @param length The length of the identifier.
+ * @param found Set to true if the identifier is a keyword or a type.
+ * @return Keyword or Type.
+ */
+CppLexer::TokenKind CppLexer::wordKind(const QChar* word, int length, bool& found) {
+    found = false;
+    if (length < MinWordLength || length > MaxWordLength) {
+        return Keyword;
+    }
+    int index = WordSlots.slots[wordHash(word[0].unicode(), word[1].unicode(), word[length - 1].unicode(), length)];
+    if (index < 0) {
+        return Keyword;
+    }
+    const char* text = Words[index].text;
+    for (int i = 0; i < length; ++i) {
+        if (word[i].unicode() != ushort(text[i])) {
+            return Keyword;
+        }
+    }
+    found = text[length] == '\0';
+    return Words[index].kind;
+}
+
+/**
+ * @brief Returns the index of a raw string delimiter, adding it if needed.
+ *
+ * The same delimiter always gets the same index, so line states stay comparable.
+ *
+ * @param delimiter The delimiter.
+ * @return The delimiter index.
+ */
+int CppLexer::internDelimiter(const QString& delimiter) {
+    QMutexLocker locker(&delimiterMutex);
+    int index = delimiters.indexOf(delimiter);
+    if (index < 0) {
+        index = delimiters.size();
+        delimiters.append(delimiter);
+    }
+    return index;
+}
+
+/**
+ * @brief Returns a raw string delimiter by index.
+ * @param index The delimiter index.
+ * @return The delimiter.
+ */
+QString CppLexer::delimiter(int index) {
+    QMutexLocker locker(&delimiterMutex);
+    return delimiters.value(index);
+}
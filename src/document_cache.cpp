@@ -0,0 +1,190 @@
+#include "../includes/document_cache.hpp"
+
+/**
+ * @class DocumentCache
+ * @brief Keeps the documents of recently opened files alive, within a memory budget.
+ *
+ * Each cached QTextDocument keeps its syntax highlighting, undo stack and
+ * layout, so switching back to a file only swaps the editor's document. The
+ * cursor and scroll position of each file are remembered alongside. When the
+ * estimated size of the cached documents exceeds the budget, the least
+ * recently used documents are deleted. The current document, the document
+ * displayed in the editor (which still shows the previous file while a large
+ * file is viewed), the document being inserted and documents with unsaved
+ * changes are never evicted.
+ */
+
+/**
+ * @brief Constructs an empty cache.
+ * @param budget The memory budget in bytes.
+ * @param parent The parent object.
+ */
+DocumentCache::DocumentCache(qint64 budget, QObject* parent)
+    : QObject(parent)
+    , displayed(nullptr)
+    , clock(0)
+    , memoryBudget(budget)
+{
+}
+
+/**
+ * @brief Looks up the document of a file and marks it as recently used.
+ * @param path The file path.
+ * @return The document, or nullptr if the file is not cached.
+ */
+QTextDocument* DocumentCache::document(const QString& path) {
+    auto it = entries.find(path);
+    if (it == entries.end()) {
+        return nullptr;
+    }
+    it->lastUsed = ++clock;
+    return it->document;
+}
+
+/**
+ * @brief Adds the document of a file, replacing any cached one.
+ *
+ * The cache becomes the parent of the document. Older documents may be
+ * evicted to stay within the budget, the inserted one never is, even if it
+ * exceeds the budget on its own.
+ *
+ * @param path The file path.
+ * @param document The document holding the file content.
+ */
+void DocumentCache::insert(const QString& path, QTextDocument* document) {
+    auto it = entries.find(path);
+    if (it != entries.end() && it->document != document) {
+        delete it->document;
+    }
+    document->setParent(this);
+    entries.insert(path, Entry{document, ViewState(), ++clock});
+    evict(path);
+}
+
+/**
+ * @brief Removes a file from the cache and deletes its document.
+ *
+ * The document must no longer be shown in the editor.
+ *
+ * @param path The file path.
+ */
+void DocumentCache::remove(const QString& path) {
+    auto it = entries.find(path);
+    if (it == entries.end()) {
+        return;
+    }
+    if (it->document == displayed) {
+        displayed = nullptr;
+    }
+    delete it->document;
+    entries.erase(it);
+    if (current == path) {
+        current.clear();
+    }
+}
+
+/**
+ * @brief Sets the file shown in the editor, whose document is never evicted.
+ * @param path The file path, which does not need to be cached.
+ */
+void DocumentCache::setCurrent(const QString& path) {
+    current = path;
+    document(path);
+    evict();
+}
+
+/**
+ * @brief Sets the document displayed by the editor, which is never evicted.
+ * @param document The document, which does not need to be cached.
+ */
+void DocumentCache::setDisplayed(const QTextDocument* document) {
+    displayed = document;
+}
+
+/**
+ * @brief Returns the files whose documents have unsaved changes.
+ * @return The file paths, sorted.
+ */
+QStringList DocumentCache::modifiedPaths() const {
+    QStringList paths;
+    for (auto it = entries.constBegin(); it != entries.constEnd(); ++it) {
+        if (it->document->isModified()) {
+            paths.append(it.key());
+        }
+    }
+    paths.sort();
+    return paths;
+}
+
+/**
+ * @brief Returns the remembered cursor and scroll position of a file.
+ * @param path The file path.
+ * @return The view state, at the start of the file if unknown.
+ */
+DocumentCache::ViewState DocumentCache::viewState(const QString& path) const {
+    auto it = entries.constFind(path);
+    return it != entries.constEnd() ? it->view : ViewState();
+}
+
+/**
+ * @brief Remembers the cursor and scroll position of a cached file.
+ * @param path The file path.
+ * @param state The view state.
+ */
+void DocumentCache::setViewState(const QString& path, const ViewState& state) {
+    auto it = entries.find(path);
+    if (it != entries.end()) {
+        it->view = state;
+    }
+}
+
+/**
+ * @brief Returns the estimated memory used by all cached documents.
+ * @return The size in bytes.
+ */
+qint64 DocumentCache::memoryUsage() const {
+    qint64 usage = 0;
+    for (const Entry& entry : entries) {
+        usage += estimateSize(entry.document);
+    }
+    return usage;
+}
+
+/**
+ * @brief Estimates the memory used by a document.
+ *
+ * Counts the UTF-16 text plus a fixed cost per block for its layout,
+ * formats and highlighting state.
+ *
+ * @param document The document.
+ * @return The estimated size in bytes.
+ */
+qint64 DocumentCache::estimateSize(const QTextDocument* document) {
+    return qint64(document->characterCount()) * 2 + qint64(document->blockCount()) * 256;
+}
+
+/**
+ * @brief Deletes least recently used documents until the cache fits its budget.
+ * @param keep A file whose document must be kept as well, such as the one being inserted.
+ */
+void DocumentCache::evict(const QString& keep) {
+    qint64 usage = memoryUsage();
+    while (usage > memoryBudget) {
+        auto victim = entries.end();
+        for (auto it = entries.begin(); it != entries.end(); ++it) {
+            if (it.key() == current || it.key() == keep || it->document == displayed ||
+                it->document->isModified()) {
+                continue;
+            }
+            if (victim == entries.end() || it->lastUsed < victim->lastUsed) {
+                victim = it;
+            }
+        }
+        if (victim == entries.end()) {
+            return; // Everything left is in use or unsaved
+        }
+        usage -= estimateSize(victim->document);
+        delete victim->document;
+        entries.erase(victim);
+    }
+}
@@ -0,0 +1,213 @@
+#include "../includes/document_loader.hpp"
+#include "../includes/source_editor.hpp"
+#include "../includes/lexer_registry.hpp"
+#include <QRunnable>
+#include <QFile>
+#include <QTextCodec>
+#include <QTextDecoder>
+#include <QThread>
+#include <QMetaObject>
+#include <QScopedPointer>
+#include <functional>
+#include <climits>
+
+/**
+ * @class DocumentLoader
+ * @brief Reads, decodes and builds the document of a file on a worker thread.
+ *
+ * The file is read in chunks and decoded incrementally, so a slow disk or
+ * network mount only stalls the worker. The QTextDocument is filled on the
+ * worker as well and then moved to the UI thread, where the editor takes it
+ * over with setDocument() instead of building it with setPlainText(). The
+ * length of the longest line is measured on the worker too, and the lexer is
+ * chosen there from the head of the file, so minified or generated files are
+ * recognised and languages sniffed without reading them again. Progress is
+ * reported once per chunk. Loading another file bumps a generation
+ * counter: the previous load stops at its next chunk and its document is
+ * discarded.
+ */
+
+namespace {
+const qint64 ChunkSize = 1024 * 1024;
+
+typedef std::function<void(int, QTextDocument*, int, const Lexer*, const QString&)> FinishCallback;
+
+class LoadTask : public QRunnable {
+public:
+    LoadTask(const QString& path, QThread* target,
+             const QSharedPointer<QAtomicInt>& generation,
+             const std::function<void(int, qint64, qint64)>& progress,
+             const FinishCallback& finish)
+        : path(path), target(target), generation(generation),
+          id(generation->loadAcquire()), progress(progress), finish(finish) {}
+
+    void run() override {
+        QFile file(path);
+        if (!file.open(QIODevice::ReadOnly)) {
+            finish(id, nullptr, 0, nullptr, file.errorString());
+            return;
+        }
+
+        const qint64 total = file.size();
+        QString text;
+        text.reserve(int(qMin<qint64>(total, INT_MAX / 2)));
+        QScopedPointer<QTextDecoder> decoder;
+        QByteArray head;
+        qint64 bytesRead = 0;
+
+        while (!file.atEnd()) {
+            if (cancelled()) {
+                return;
+            }
+            QByteArray chunk = file.read(ChunkSize);
+            if (chunk.isEmpty()) {
+                if (file.error() != QFileDevice::NoError) {
+                    finish(id, nullptr, 0, nullptr, file.errorString());
+                    return;
+                }
+                break;
+            }
+            if (!decoder) {
+                // Honour a byte order mark, as QTextStream does
+                decoder.reset(QTextCodec::codecForUtfText(chunk, QTextCodec::codecForLocale())->makeDecoder());
+            }
+            if (head.size() < LexerRegistry::SampleSize) {
+                head += chunk.left(LexerRegistry::SampleSize - head.size());
+            }
+            text += decoder->toUnicode(chunk);
+            bytesRead += chunk.size();
+            if (total > ChunkSize) {
+                progress(id, bytesRead, total);
+            }
+        }
+        text.replace(QLatin1String("\r\n"), QLatin1String("\n"));
+
+        int longestLine = 0;
+        for (int start = 0; start <= text.size();) {
+            int end = text.indexOf(QLatin1Char('\n'), start);
+            if (end < 0) {
+                end = text.size();
+            }
+            longestLine = qMax(longestLine, end - start);
+            start = end + 1;
+        }
+
+        const Lexer* lexer = LexerRegistry::instance().lexerForContent(path, total, head, longestLine);
+
+        if (cancelled()) {
+            return;
+        }
+        QTextDocument* document = new QTextDocument();
+        SourceEditor::prepareDocument(document);
+        document->setPlainText(text);
+        document->setModified(false);
+        if (cancelled()) {
+            delete document;
+            return;
+        }
+        document->moveToThread(target);
+        finish(id, document, longestLine, lexer, QString());
+    }
+
+private:
+    bool cancelled() const {
+        return generation->loadAcquire() != id;
+    }
+
+    QString path;
+    QThread* target;
+    QSharedPointer<QAtomicInt> generation;
+    int id;
+    std::function<void(int, qint64, qint64)> progress;
+    FinishCallback finish;
+};
+}
+
+/**
+ * @brief Constructs a loader with its own worker threads.
+ * @param parent The parent object.
+ */
+DocumentLoader::DocumentLoader(QObject* parent)
+    : QObject(parent)
+    , generation(new QAtomicInt(0))
+    , loading(false)
+{
+    // A load stuck on a slow mount must not hold up the next one
+    pool.setMaxThreadCount(2);
+}
+
+/**
+ * @brief Cancels the running load and waits for the workers to stop.
+ */
+DocumentLoader::~DocumentLoader() {
+    cancel();
+    pool.waitForDone();
+}
+
+/**
+ * @brief Starts loading a file, cancelling any load in progress.
+ *
+ * Emits loaded() with the new document, or failed(), unless the load is
+ * cancelled first.
+ *
+ * @param path The file to load.
+ */
+void DocumentLoader::load(const QString& path) {
+    cancel();
+    this->path = path;
+    loading = true;
+
+    auto progress = [this](int id, qint64 bytesRead, qint64 totalBytes) {
+        QMetaObject::invokeMethod(this, [this, id, bytesRead, totalBytes]() {
+            reportProgress(id, bytesRead, totalBytes);
+        }, Qt::QueuedConnection);
+    };
+    auto done = [this](int id, QTextDocument* document, int longestLine, const Lexer* lexer, const QString& error) {
+        QMetaObject::invokeMethod(this, [this, id, document, longestLine, lexer, error]() {
+            finish(id, document, longestLine, lexer, error);
+        }, Qt::QueuedConnection);
+    };
+    pool.start(new LoadTask(path, thread(), generation, progress, done));
+}
+
+/**
+ * @brief Stops the running load. Nothing is emitted for it afterwards.
+ */
+void DocumentLoader::cancel() {
+    generation->fetchAndAddOrdered(1);
+    loading = false;
+}
+
+/**
+ * @brief Forwards the progress of the current load.
+ * @param id The generation of the load reporting progress.
+ * @param bytesRead The number of bytes read so far.
+ * @param totalBytes The size of the file.
+ */
+void DocumentLoader::reportProgress(int id, qint64 bytesRead, qint64 totalBytes) {
+    if (id == generation->loadAcquire()) {
+        emit progress(bytesRead, totalBytes);
+    }
+}
+
+/**
+ * @brief Hands the loaded document over, or drops it if the load was cancelled.
+ * @param id The generation of the finished load.
+ * @param document The document built by the worker, nullptr on failure.
+ * @param longestLine The length of the longest line, in characters.
+ * @param lexer The lexer chosen for the file, nullptr for plain text.
+ * @param error The error message, empty on success.
+ */
+void DocumentLoader::finish(int id, QTextDocument* document, int longestLine, const Lexer* lexer,
+                            const QString& error) {
+    if (id != generation->loadAcquire()) {
+        delete document;
+        return;
+    }
+    loading = false;
+    if (document) {
+        emit loaded(path, document, longestLine, lexer);
+    } else {
+        emit failed(path, error);
+    }
+}
@@ -0,0 +1,471 @@
+#include "../includes/editor_decorator.hpp"
+#include "../includes/line_index.hpp"
+#include <QScrollBar>
+#include <QPen>
+#include <QColor>
+#include <QFont>
+
+/**
+ * @class EditorDecorator
+ * @brief Owns the extra selections of the text editor, grouped in layers.
+ *
+ * Finding decorations are virtualized: only the findings overlapping the
+ * viewport, plus one page above and below, are turned into selections. When
+ * scrolling leaves that window the decorations are rebuilt from the finding
+ * index, so the editor never lays out or paints selections for thousands of
+ * off-screen findings. Matches of the attached search engine are virtualized
+ * the same way. Pinned findings hold explicit selections. Layers are drawn in
+ * order, later layers on top.
+ */
+
+namespace {
+// Characters scanned after a finding's column to select the code it points at
+const int MaxConstructLength = 512;
+}
+
+/**
+ * @brief Attaches a decorator to a text editor.
+ * @param editor The editor to decorate. It also becomes the parent object.
+ */
+EditorDecorator::EditorDecorator(SourceEditor* editor)
+    : QObject(editor)
+    , textEditor(editor)
+    , findings(FindingStore::empty())
+    , index(nullptr)
+    , fileId(-1)
+    , search(nullptr)
+    , materializedFirst(1)
+    , materializedLast(0)
+{
+    connect(textEditor->verticalScrollBar(), &QScrollBar::valueChanged,
+            this, &EditorDecorator::updateViewport);
+    textEditor->viewport()->installEventFilter(this);
+}
+
+/**
+ * @brief Sets the findings decorated in the editor.
+ * @param findings The findings the index was built from.
+ * @param index The finding index, which must outlive its use by the decorator.
+ * @param fileId The index ID of the file shown in the editor, -1 if none.
+ */
+void EditorDecorator::setFindings(const FindingSnapshot& findings, const FindingIndex* index, int fileId) {
+    this->findings = findings;
+    this->index = index;
+    this->fileId = fileId;
+
+    // Force a rebuild for the current viewport
+    materializedFirst = 1;
+    materializedLast = 0;
+    updateViewport();
+}
+
+/**
+ * @brief Attaches the search engine whose matches are decorated.
+ * @param engine The search engine, or nullptr to remove the search highlights.
+ */
+void EditorDecorator::setSearch(const SearchEngine* engine) {
+    search = engine;
+    layers[SearchLayer].clear();
+    if (search) {
+        refreshSearch();
+    } else {
+        apply();
+    }
+}
+
+/**
+ * @brief Rebuilds the search decorations after the matches changed.
+ */
+void EditorDecorator::refreshSearch() {
+    materializedFirst = 1;
+    materializedLast = 0;
+    updateViewport();
+}
+
+/**
+ * @brief Replaces the selections of a layer.
+ * @param layer The layer to update.
+ * @param selections The new selections.
+ */
+void EditorDecorator::setSelections(Layer layer, const QList<QTextEdit::ExtraSelection>& selections) {
+    layers[layer] = selections;
+    apply();
+}
+
+/**
+ * @brief Appends selections to a layer.
+ * @param layer The layer to update.
+ * @param selections The selections to add.
+ */
+void EditorDecorator::addSelections(Layer layer, const QList<QTextEdit::ExtraSelection>& selections) {
+    layers[layer].append(selections);
+    apply();
+}
+
+/**
+ * @brief Removes every selection of a layer.
+ * @param layer The layer to clear.
+ */
+void EditorDecorator::clear(Layer layer) {
+    if (layer == FindingLayer) {
+        findings = FindingStore::empty();
+        index = nullptr;
+        fileId = -1;
+    } else if (layer == SearchLayer) {
+        search = nullptr;
+    }
+    layers[layer].clear();
+    apply();
+}
+
+/**
+ * @brief Removes every selection and forgets the decorated findings.
+ */
+void EditorDecorator::clearAll() {
+    findings = FindingStore::empty();
+    index = nullptr;
+    fileId = -1;
+    search = nullptr;
+    for (QList<QTextEdit::ExtraSelection>& layer : layers) {
+        layer.clear();
+    }
+    apply();
+}
+
+/**
+ * @brief Rebuilds the viewport window when the viewport is resized.
+ * @param obj The object receiving the event.
+ * @param event The event to be processed.
+ * @return Always false, the event is not consumed.
+ */
+bool EditorDecorator::eventFilter(QObject* obj, QEvent* event) {
+    if (obj == textEditor->viewport() && event->type() == QEvent::Resize) {
+        updateViewport();
+    }
+    return QObject::eventFilter(obj, event);
+}
+
+/**
+ * @brief Materializes the decorations around the viewport if it left the current window.
+ */
+void EditorDecorator::updateViewport() {
+    if ((!index || fileId < 0) && !search) {
+        if (!layers[FindingLayer].isEmpty()) {
+            layers[FindingLayer].clear();
+            apply();
+        }
+        return;
+    }
+
+    int firstVisible = textEditor->cursorForPosition(QPoint(0, 0)).blockNumber() + 1;
+    int lastVisible = textEditor->cursorForPosition(QPoint(0, textEditor->viewport()->height() - 1)).blockNumber() + 1;
+    if (firstVisible >= materializedFirst && lastVisible <= materializedLast) {
+        return;
+    }
+
+    // Keep a page of margin on both sides so small scrolls reuse the window
+    int page = lastVisible - firstVisible + 1;
+    materialize(qMax(1, firstVisible - page), lastVisible + page);
+}
+
+/**
+ * @brief Builds the virtualized decorations of a range of lines.
+ * @param firstLine The first line of the range (1-based, inclusive).
+ * @param lastLine The last line of the range (1-based, inclusive).
+ */
+void EditorDecorator::materialize(int firstLine, int lastLine) {
+    materializedFirst = firstLine;
+    materializedLast = lastLine;
+    materializeFindings(firstLine, lastLine);
+    materializeSearch(firstLine, lastLine);
+    apply();
+}
+
+/**
+ * @brief Builds the finding decorations of a range of lines.
+ * @param firstLine The first line of the range (1-based, inclusive).
+ * @param lastLine The last line of the range (1-based, inclusive).
+ */
+void EditorDecorator::materializeFindings(int firstLine, int lastLine) {
+    layers[FindingLayer].clear();
+    if (!index || fileId < 0) {
+        return;
+    }
+
+    QTextDocument* document = textEditor->document();
+    QTextBlock block;
+    for (int row : index->findingsInRange(fileId, firstLine, lastLine)) {
+        if (findings->ruleId(row).isEmpty()) {
+            continue;
+        }
+
+        // Rows come in line order: walk short gaps, jump over long ones
+        int blockNumber = findings->line(row) - 1;
+        if (block.isValid() && blockNumber - block.blockNumber() <= 16) {
+            while (block.isValid() && block.blockNumber() < blockNumber) {
+                block = block.next();
+            }
+        } else {
+            block = document->findBlockByNumber(blockNumber);
+        }
+        if (!block.isValid()) {
+            break; // Past the end of the document
+        }
+
+        appendFindingSelections(block, findings->toResult(row), layers[FindingLayer]);
+    }
+}
+
+/**
+ * @brief Builds the search match decorations of a range of lines.
+ * @param firstLine The first line of the range (1-based, inclusive).
+ * @param lastLine The last line of the range (1-based, inclusive).
+ */
+void EditorDecorator::materializeSearch(int firstLine, int lastLine) {
+    if (!search) {
+        return;
+    }
+    layers[SearchLayer].clear();
+
+    QTextDocument* document = textEditor->document();
+    QTextBlock first = document->findBlockByNumber(firstLine - 1);
+    QTextBlock last = document->findBlockByNumber(lastLine - 1);
+    if (!first.isValid()) {
+        return;
+    }
+    int end = last.isValid() ? last.position() + last.length() : document->characterCount();
+
+    QTextEdit::ExtraSelection selection;
+    selection.format.setBackground(QColor(255, 255, 0, 100));  // Semi-transparent yellow
+    selection.format.setForeground(Qt::black);  // Ensure text remains readable
+
+    // Matches may lag behind edits until the search is run again
+    const int lastPosition = document->characterCount() - 1;
+    const QVector<TextMatch>& matches = search->matches();
+    QPair<int, int> range = search->matchRange(first.position(), end);
+    for (int i = range.first; i < range.second; ++i) {
+        selection.cursor = QTextCursor(document);
+        selection.cursor.setPosition(matches[i].position);
+        selection.cursor.setPosition(qMin(matches[i].position + matches[i].length, lastPosition), QTextCursor::KeepAnchor);
+        layers[SearchLayer].append(selection);
+    }
+}
+
+/**
+ * @brief Applies all layers to the editor in a single update.
+ */
+void EditorDecorator::apply() {
+    QList<QTextEdit::ExtraSelection> selections;
+    for (const QList<QTextEdit::ExtraSelection>& layer : layers) {
+        selections.append(layer);
+    }
+    textEditor->setExtraSelections(selections);
+}
+
+/**
+ * @brief Converts a finding column to a document position.
+ *
+ * UTF-16 columns, the SARIF default, map directly. Other units read only the
+ * start of the line, up to the column, so a long line is never copied whole.
+ *
+ * @param block The block of the line.
+ * @param column The column (1-based), clamped to the line.
+ * @param kind The unit the column counts.
+ * @return The position in the document.
+ */
+int EditorDecorator::columnPosition(const QTextBlock& block, int column, AuditResult::ColumnKind kind) {
+    const int length = block.length() - 1;
+    if (kind == AuditResult::Utf16CodeUnits || column <= 1) {
+        return block.position() + qBound(0, column - 1, length);
+    }
+
+    // A column never spans more than two UTF-16 code units
+    QTextCursor prefix(block);
+    prefix.setPosition(block.position() + int(qMin<qint64>(qint64(column - 1) * 2, length)), QTextCursor::KeepAnchor);
+    QString text = prefix.selectedText();
+    return block.position() + LineIndex::columnOffset(text.constData(), text.size(), column, kind);
+}
+
+/**
+ * @brief Selects the problematic code of a finding.
+ * 
+ * Uses the column range reported by the analysis, or selects the identifier,
+ * call or string literal found at the start column.
+ * 
+ * @param block The block of the line the finding starts on.
+ * @param result The audit result.
+ * @return The cursor selecting the code.
+ */
+QTextCursor EditorDecorator::codeCursor(const QTextBlock& block, const AuditResult& result) {
+    QTextCursor specificCursor(block);
+    
+    // Move to the specified column if available
+    if (result.getColumn() > 0) {
+        specificCursor.setPosition(columnPosition(block, result.getColumn(), result.getColumnKind()));
+    }
+    
+    // Select the problematic text with enhanced logic
+    int selectionLength = 1;
+    if (result.getEndColumn() > result.getColumn()) {
+        int end = columnPosition(block, result.getEndColumn(), result.getColumnKind());
+        selectionLength = qMax(1, end - specificCursor.position());
+    } else {
+        // Enhanced text selection logic, on a window after the column so that
+        // a finding deep into a very long line does not copy the whole line
+        QTextCursor window(specificCursor);
+        window.setPosition(qMin(specificCursor.position() + MaxConstructLength,
+                                block.position() + block.length() - 1), QTextCursor::KeepAnchor);
+        QString lineText = window.selectedText();
+        int startPos = 0;
+        
+        // Try to select meaningful code constructs
+        if (startPos < lineText.length()) {
+            QChar currentChar = lineText[startPos];
+            
+            // If we're at a function call, select the whole function
+            if (currentChar.isLetter() || currentChar == '_') {
+                // Select identifier
+                while (startPos + selectionLength < lineText.length() && 
+                       (lineText[startPos + selectionLength].isLetterOrNumber() || 
+                        lineText[startPos + selectionLength] == '_')) {
+                    selectionLength++;
+                }
+                
+                // If followed by '(', include the parentheses and arguments
+                if (startPos + selectionLength < lineText.length() && 
+                    lineText[startPos + selectionLength] == '(') {
+                    int parenCount = 0;
+                    while (startPos + selectionLength < lineText.length()) {
+                        QChar c = lineText[startPos + selectionLength];
+                        selectionLength++;
+                        if (c == '(') parenCount++;
+                        else if (c == ')') {
+                            parenCount--;
+                            if (parenCount == 0) break;
+                        }
+                    }
+                }
+            }
+            // If we're at a string literal, select the whole string
+            else if (currentChar == '"' || currentChar == '\'') {
+                QChar quote = currentChar;
+                selectionLength = 1;
+                while (startPos + selectionLength < lineText.length()) {
+                    QChar c = lineText[startPos + selectionLength];
+                    selectionLength++;
+                    if (c == quote && lineText[startPos + selectionLength - 2] != '\\') {
+                        break;
+                    }
+                }
+            }
+        }
+        
+        // Ensure minimum visibility
+        if (selectionLength < 3) {
+            selectionLength = qMin(10, lineText.length() - startPos);
+        }
+    }
+    
+    int selectionEnd = qMin(specificCursor.position() + selectionLength, block.position() + block.length() - 1);
+    specificCursor.setPosition(selectionEnd, QTextCursor::KeepAnchor);
+    return specificCursor;
+}
+
+/**
+ * @brief Builds the line, code and margin highlights of a finding.
+ * @param block The block of the line the finding starts on.
+ * @param result The audit result to highlight.
+ * @param selections The list the highlights are appended to.
+ */
+void EditorDecorator::appendFindingSelections(const QTextBlock& block, const AuditResult& result,
+                                              QList<QTextEdit::ExtraSelection>& selections) {
+    QTextCursor cursor(block);
+    
+    // Get the severity level for different visual treatments
+    bool isError = result.getSeverity() == AuditResult::Error;
+    bool isWarning = result.getSeverity() == AuditResult::Warning;
+    
+    // 1. Highlight the entire line with a subtle background
+    // (block positions, as moving to the visual line ends would lay out the block)
+    QTextCursor lineHighlightCursor = cursor;
+    lineHighlightCursor.setPosition(block.position() + block.length() - 1, QTextCursor::KeepAnchor);
+    
+    QTextEdit::ExtraSelection lineHighlight;
+    lineHighlight.cursor = lineHighlightCursor;
+    if (isError) {
+        lineHighlight.format.setBackground(QColor(255, 235, 235, 140)); // Slightly more visible for errors
+        lineHighlight.format.setProperty(QTextFormat::FullWidthSelection, true);
+    } else if (isWarning) {
+        lineHighlight.format.setBackground(QColor(255, 248, 220, 140)); // Slightly more visible for warnings
+        lineHighlight.format.setProperty(QTextFormat::FullWidthSelection, true);
+    } else {
+        lineHighlight.format.setBackground(QColor(245, 245, 255, 140)); // Slightly more visible for info
+        lineHighlight.format.setProperty(QTextFormat::FullWidthSelection, true);
+    }
+    selections.append(lineHighlight);
+    
+    // 2. Highlight the specific problematic code section
+    QTextCursor specificCursor = codeCursor(block, result);
+    
+    // Create enhanced specific highlight with more prominent styling
+    QTextEdit::ExtraSelection specificHighlight;
+    specificHighlight.cursor = specificCursor;
+    
+    if (isError) {
+        // Error styling - bright red with strong emphasis and border
+        specificHighlight.format.setBackground(QColor(255, 80, 80, 220));
+        specificHighlight.format.setForeground(QColor(255, 255, 255));
+        specificHighlight.format.setFontWeight(QFont::Bold);
+        specificHighlight.format.setUnderlineColor(QColor(200, 0, 0));
+        specificHighlight.format.setUnderlineStyle(QTextCharFormat::WaveUnderline);
+        specificHighlight.format.setProperty(QTextFormat::OutlinePen, QPen(QColor(150, 0, 0), 3));
+    } else if (isWarning) {
+        // Warning styling - orange/yellow with medium emphasis and border
+        specificHighlight.format.setBackground(QColor(255, 140, 0, 200));
+        specificHighlight.format.setForeground(QColor(255, 255, 255));
+        specificHighlight.format.setFontWeight(QFont::Bold);
+        specificHighlight.format.setUnderlineColor(QColor(255, 140, 0));
+        specificHighlight.format.setUnderlineStyle(QTextCharFormat::WaveUnderline);
+        specificHighlight.format.setProperty(QTextFormat::OutlinePen, QPen(QColor(200, 100, 0), 2));
+    } else {
+        // Info styling - blue with subtle emphasis and border
+        specificHighlight.format.setBackground(QColor(100, 150, 255, 170));
+        specificHighlight.format.setForeground(QColor(255, 255, 255));
+        specificHighlight.format.setFontWeight(QFont::Bold);
+        specificHighlight.format.setUnderlineColor(QColor(0, 100, 200));
+        specificHighlight.format.setUnderlineStyle(QTextCharFormat::DotLine);
+        specificHighlight.format.setProperty(QTextFormat::OutlinePen, QPen(QColor(0, 100, 200), 1));
+    }
+    
+    // Enhanced tooltip with more information and emojis
+    QString tooltip = QString("🚨 SECURITY ISSUE DETECTED 🚨\n\n"
+                             "🔍 Rule: %1\n"
+                             "📝 Description: %2\n"
+                             "📍 Location: Line %3, Column %4\n\n"
+                             "💡 Click to see full details in results panel")
+                     .arg(result.getRuleId())
+                     .arg(result.getMessage().split('\n').first()) // First line of message
+                     .arg(result.getLine())
+                     .arg(result.getColumn());
+    specificHighlight.format.setToolTip(tooltip);
+    
+    selections.append(specificHighlight);
+    
+    // 3. Add a prominent left margin indicator with icon-like effect
+    QTextCursor marginCursor = cursor;
+    marginCursor.setPosition(qMin(block.position() + 2, block.position() + block.length() - 1), QTextCursor::KeepAnchor);
+    
+    QTextEdit::ExtraSelection marginHighlight;
+    marginHighlight.cursor = marginCursor;
+    if (isError) {
+        marginHighlight.format.setBackground(QColor(255, 0, 0, 150));
+        marginHighlight.format.setProperty(QTextFormat::OutlinePen, QPen(QColor(200, 0, 0), 4));
+    } else if (isWarning) {
+        marginHighlight.format.setBackground(QColor(255, 165, 0, 150));
+        marginHighlight.format.setProperty(QTextFormat::OutlinePen, QPen(QColor(200, 100, 0), 3));
+    } else {
+        marginHighlight.format.setBackground(QColor(0, 100, 255, 150));
+        marginHighlight.format.setProperty(QTextFormat::OutlinePen, QPen(QColor(0, 100, 200), 2));
+    }
+    selections.append(marginHighlight);
+}
@@ -0,0 +1,162 @@
+#include "../includes/emphasis_overlay.hpp"
+#include <QPainter>
+#include <QScrollBar>
+#include <QTextBlock>
+
+/**
+ * @class EmphasisOverlay
+ * @brief Transparent widget drawing the blinking emphasis over a finding.
+ *
+ * The overlay sits on top of the editor viewport and paints the emphasis
+ * itself instead of toggling an extra selection, so a blink neither touches
+ * the document formats nor relayouts the editor: each tick only invalidates
+ * the rectangle of the focused finding. The overlay is a sibling of the
+ * viewport so that scrolling the viewport does not move it.
+ */
+
+namespace {
+const int BlinkInterval = 500;
+const int BlinkCount = 6;
+const int OutlineWidth = 3;
+}
+
+/**
+ * @brief Creates the overlay of a text editor.
+ * @param editor The editor to draw over. It also becomes the parent widget.
+ */
+EmphasisOverlay::EmphasisOverlay(SourceEditor* editor)
+    : QWidget(editor)
+    , textEditor(editor)
+    , blinkTimer(new QTimer(this))
+    , visibleState(false)
+    , remainingBlinks(0)
+{
+    setAttribute(Qt::WA_TransparentForMouseEvents);
+    setAttribute(Qt::WA_NoSystemBackground);
+    setFocusPolicy(Qt::NoFocus);
+    setGeometry(textEditor->viewport()->geometry());
+    hide();
+
+    blinkTimer->setInterval(BlinkInterval);
+    connect(blinkTimer, &QTimer::timeout, this, &EmphasisOverlay::blink);
+    connect(textEditor->verticalScrollBar(), &QScrollBar::valueChanged, this, &EmphasisOverlay::updateTarget);
+    connect(textEditor->horizontalScrollBar(), &QScrollBar::valueChanged, this, &EmphasisOverlay::updateTarget);
+    connect(textEditor, &SourceEditor::textChanged, this, &EmphasisOverlay::updateTarget);
+    textEditor->viewport()->installEventFilter(this);
+}
+
+/**
+ * @brief Starts blinking over a range of text for a few seconds.
+ * @param cursor The cursor selecting the text to emphasize.
+ * @param color The emphasis color.
+ */
+void EmphasisOverlay::start(const QTextCursor& cursor, const QColor& color) {
+    stop();
+
+    this->cursor = cursor;
+    this->color = color;
+    visibleState = false;
+    remainingBlinks = BlinkCount;
+    currentRect = targetRect();
+
+    setGeometry(textEditor->viewport()->geometry());
+    show();
+    raise();
+    blinkTimer->start();
+}
+
+/**
+ * @brief Stops blinking and erases the emphasis.
+ */
+void EmphasisOverlay::stop() {
+    blinkTimer->stop();
+    if (visibleState) {
+        visibleState = false;
+        update(currentRect);
+    }
+    hide();
+}
+
+/**
+ * @brief Toggles the emphasis, repainting only the finding's rectangle.
+ */
+void EmphasisOverlay::blink() {
+    if (remainingBlinks-- <= 0) {
+        stop();
+        return;
+    }
+    visibleState = !visibleState;
+    update(currentRect);
+}
+
+/**
+ * @brief Follows the finding when the editor scrolls or its text moves.
+ */
+void EmphasisOverlay::updateTarget() {
+    if (!isActive()) {
+        return;
+    }
+    QRect rect = targetRect();
+    if (rect != currentRect) {
+        update(currentRect);
+        currentRect = rect;
+        update(currentRect);
+    }
+}
+
+/**
+ * @brief Keeps the overlay aligned with the viewport.
+ * @param obj The object receiving the event.
+ * @param event The event to be processed.
+ * @return Always false, the event is not consumed.
+ */
+bool EmphasisOverlay::eventFilter(QObject* obj, QEvent* event) {
+    if (obj == textEditor->viewport() && (event->type() == QEvent::Resize || event->type() == QEvent::Move)) {
+        setGeometry(textEditor->viewport()->geometry());
+        updateTarget();
+    }
+    return QWidget::eventFilter(obj, event);
+}
+
+/**
+ * @brief Paints the emphasis when it is in its visible phase.
+ * @param event The paint event.
+ */
+void EmphasisOverlay::paintEvent(QPaintEvent* event) {
+    if (!visibleState || !event->rect().intersects(currentRect)) {
+        return;
+    }
+
+    QPainter painter(this);
+    painter.setRenderHint(QPainter::Antialiasing);
+    QColor fill = color;
+    fill.setAlpha(90);
+    painter.setBrush(fill);
+    painter.setPen(QPen(QColor(0, 0, 0), OutlineWidth));
+    painter.drawRoundedRect(currentRect.adjusted(OutlineWidth, OutlineWidth, -OutlineWidth, -OutlineWidth), 3, 3);
+}
+
+/**
+ * @brief Computes the viewport rectangle covering the emphasized text.
+ *
+ * Selections spanning several lines are covered up to the viewport's right
+ * edge.
+ *
+ * @return The rectangle in overlay coordinates, including the outline margin.
+ */
+QRect EmphasisOverlay::targetRect() const {
+    QTextCursor start(cursor);
+    start.setPosition(cursor.selectionStart());
+    QTextCursor end(cursor);
+    end.setPosition(cursor.selectionEnd());
+
+    QRect startRect = textEditor->cursorRect(start);
+    QRect endRect = textEditor->cursorRect(end);
+    QRect rect;
+    if (startRect.top() == endRect.top()) {
+        rect = QRect(startRect.topLeft(), endRect.bottomRight());
+    } else {
+        rect = QRect(QPoint(startRect.left(), startRect.top()), QPoint(width(), endRect.bottom()));
+    }
+    return rect.normalized().adjusted(-OutlineWidth - 1, -OutlineWidth - 1, OutlineWidth + 1, OutlineWidth + 1);
+}
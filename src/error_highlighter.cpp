@@ -1,45 +1,418 @@
 #include "../includes/error_highlighter.hpp"
-#include <QTextDocument>
-#include <QTextCursor>
-#include <QTextCharFormat>
+#include "../includes/finding_index.hpp"
+#include "../includes/line_index.hpp"
 #include <QFile>
-#include <QTextStream>
-
-/**
- * @brief Highlights errors in the specified file based on audit results.
- * @param file The file to highlight errors in.
- * @param results The list of audit results containing error information.
- */
-void ErrorHighlighter::highlightErrors(const QString& file, const QList<AuditResult>& results) {
-    QFile sourceFile(file);
-    if (!sourceFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        return;
-    }
-
-    QTextStream in(&sourceFile);
-    QString content = in.readAll();
-    sourceFile.close();
-
-    QTextDocument document;
-    document.setPlainText(content);
-
-    QTextCharFormat errorFormat;
-    errorFormat.setBackground(Qt::red);
-    errorFormat.setForeground(Qt::white);
-
-    for (const AuditResult& result : results) {
-        if (result.getFileName() == file) {
-            for (const QString& issue : result.getIssues()) {
-                QTextCursor cursor(&document);
-                cursor.movePosition(QTextCursor::Start);
-                
-                while (!cursor.atEnd()) {
-                    cursor.movePosition(QTextCursor::NextWord);
-                    if (cursor.selectedText().contains(issue)) {
-                        cursor.mergeCharFormat(errorFormat);
-                    }
-                }
+#include <QDir>
+#include <QThread>
+#include <QThreadPool>
+#include <QRunnable>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QWaitCondition>
+#include <algorithm>
+#include <climits>
+#include <functional>
+
+/**
+ * @class ErrorHighlighter
+ * @brief Writes audit findings as a self-contained annotated source report.
+ *
+ * The report is generated headless, without widgets or documents, in HTML
+ * with inline styles or in ANSI colors for a terminal. Every source file is
+ * streamed once, line by line, while its findings are taken in line order
+ * from a finding index: the lines a finding covers and a few lines of
+ * context around it are written with the code of the finding marked in its
+ * severity color and the finding described below its first line. Reading
+ * stops after the last finding of the file. Files are rendered in parallel on
+ * a thread pool and written in path order as soon as each one is ready, with
+ * a bounded number of files rendered ahead, so thousands of files never need
+ * to be held in memory at once.
+ */
+
+namespace {
+// Files rendered ahead of the one being written, per thread
+const int RenderAheadPerThread = 4;
+
+const char* const HtmlStyle =
+    "body{font-family:sans-serif;margin:2em;color:#222}"
+    "section{margin-bottom:2em}"
+    "h2{font-size:1.1em;font-family:monospace}"
+    "h2 .count{font-weight:normal;color:#666}"
+    "pre{background:#f8f8f8;border:1px solid #ddd;padding:.5em;overflow-x:auto}"
+    ".number{color:#999;user-select:none}"
+    ".gap{color:#999}"
+    "mark.error{background:#ff5050;color:#fff}"
+    "mark.warning{background:#ff8c00;color:#fff}"
+    "mark.info{background:#6496ff;color:#fff}"
+    ".note{display:block;font-weight:bold}"
+    ".note.error{color:#c00}"
+    ".note.warning{color:#c86400}"
+    ".note.info{color:#0064c8}";
+
+const char* const AnsiReset = "\x1b[0m";
+const char* const AnsiBold = "\x1b[1m";
+const char* const AnsiDim = "\x1b[2m";
+
+const char* severityName(int severity) {
+    switch (severity) {
+    case AuditResult::Error:
+        return "error";
+    case AuditResult::Warning:
+        return "warning";
+    default:
+        return "info";
+    }
+}
+
+const char* ansiMarkColor(int severity) {
+    switch (severity) {
+    case AuditResult::Error:
+        return "\x1b[41;97m";
+    case AuditResult::Warning:
+        return "\x1b[43;30m";
+    default:
+        return "\x1b[44;97m";
+    }
+}
+
+const char* ansiTextColor(int severity) {
+    switch (severity) {
+    case AuditResult::Error:
+        return "\x1b[1;31m";
+    case AuditResult::Warning:
+        return "\x1b[1;33m";
+    default:
+        return "\x1b[1;34m";
+    }
+}
+
+/**
+ * @brief Returns the analyzer message of a finding, without the parser's decorations.
+ * @param results The findings.
+ * @param row The finding.
+ * @return The message.
+ */
+QString findingMessage(const FindingSnapshot& results, int row) {
+    const QString prefix = QStringLiteral("📝 Issue: ");
+    const QStringList issues = results->issues(row);
+    for (const QString& issue : issues) {
+        if (issue.startsWith(prefix)) {
+            return issue.mid(prefix.size());
+        }
+    }
+    return issues.value(0);
+}
+
+class RenderTask : public QRunnable {
+public:
+    explicit RenderTask(const std::function<void()>& render) : render(render) {}
+
+    void run() override {
+        render();
+    }
+
+private:
+    std::function<void()> render;
+};
+}
+
+/**
+ * @brief Creates a report generator.
+ * @param format The output format.
+ */
+ErrorHighlighter::ErrorHighlighter(Format format)
+    : format(format)
+    , contextLines(3)
+    , threadCount(0)
+{
+}
+
+/**
+ * @brief Writes the report of every file that has located findings.
+ *
+ * Relative file paths are resolved against the source root, if one is set.
+ * A file that cannot be read is reported with its findings but no source.
+ *
+ * @param results The findings to report.
+ * @param out The device the report is written to.
+ * @param title The title of the report.
+ * @return False if writing to the device failed.
+ */
+bool ErrorHighlighter::writeReport(const FindingSnapshot& results, QIODevice* out, const QString& title) const {
+    FindingIndex index;
+    index.build(*results);
+
+    QVector<int> files;
+    int findingCount = 0;
+    for (int fileId = 0; fileId < index.fileCount(); ++fileId) {
+        if (index.findingCount(fileId) > 0) {
+            files.append(fileId);
+            findingCount += index.findingCount(fileId);
+        }
+    }
+    std::sort(files.begin(), files.end(), [&index](int a, int b) {
+        return index.filePath(a) < index.filePath(b);
+    });
+
+    bool ok = out->write(reportHeader(title.isEmpty() ? QStringLiteral("CoreTrace audit report") : title,
+                                      files.size(), findingCount)) >= 0;
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(threadCount > 0 ? threadCount : QThread::idealThreadCount());
+    const int renderAhead = pool.maxThreadCount() * RenderAheadPerThread;
+
+    QVector<QByteArray> parts(files.size());
+    QVector<bool> ready(files.size(), false);
+    QMutex mutex;
+    QWaitCondition rendered;
+    int started = 0;
+
+    for (int i = 0; i < files.size(); ++i) {
+        for (; started < files.size() && started < i + renderAhead; ++started) {
+            const int part = started;
+            QString path = index.filePath(files[part]);
+            if (!sourceRoot.isEmpty() && QDir::isRelativePath(path)) {
+                path = QDir(sourceRoot).filePath(path);
+            }
+            QVector<int> rows = index.findingsInRange(files[part], 1, INT_MAX);
+            pool.start(new RenderTask([this, path, rows, part, &results, &parts, &ready, &mutex, &rendered]() {
+                QByteArray text = renderFile(path, results, rows);
+                QMutexLocker locker(&mutex);
+                parts[part] = text;
+                ready[part] = true;
+                rendered.wakeAll();
+            }));
+        }
+
+        QByteArray text;
+        {
+            QMutexLocker locker(&mutex);
+            while (!ready[i]) {
+                rendered.wait(&mutex);
+            }
+            text.swap(parts[i]);
+        }
+        ok = out->write(text) == text.size() && ok;
+    }
+    pool.waitForDone();
+
+    return out->write(reportFooter()) >= 0 && ok;
+}
+
+/**
+ * @brief Renders the annotated source of one file.
+ *
+ * May be called from any thread.
+ *
+ * @param path The source file.
+ * @param results The findings.
+ * @param rows The findings of the file, ordered by start line.
+ * @return The rendered file section.
+ */
+QByteArray ErrorHighlighter::renderFile(const QString& path, const FindingSnapshot& results,
+                                        const QVector<int>& rows) const {
+    QByteArray out = fileHeader(path, rows.size());
+
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        QString reason = QString("source not available: %1").arg(file.errorString());
+        out += format == Html ? QString("<span class=\"gap\">%1</span>\n").arg(reason.toHtmlEscaped()).toUtf8()
+                              : QByteArray(AnsiDim) + reason.toUtf8() + AnsiReset + "\n";
+        for (int row : rows) {
+            out += annotation(results, row);
+        }
+        return out + fileFooter();
+    }
+
+    QVector<int> active;
+    int next = 0;
+    int showUntil = 0;
+    int lastShown = 0;
+    for (int number = 1; !file.atEnd(); ++number) {
+        QByteArray raw = file.readLine();
+        while (raw.endsWith('\n') || raw.endsWith('\r')) {
+            raw.chop(1);
+        }
+
+        // Findings covering this line
+        active.erase(std::remove_if(active.begin(), active.end(), [&results, number](int row) {
+            return qMax(results->endLine(row), results->line(row)) < number;
+        }), active.end());
+        const int firstStarting = active.size();
+        for (; next < rows.size() && results->line(rows[next]) <= number; ++next) {
+            active.append(rows[next]);
+            showUntil = qMax(showUntil, qMax(results->endLine(rows[next]), number) + contextLines);
+        }
+
+        const int nextStart = next < rows.size() ? results->line(rows[next]) : INT_MAX;
+        if (contextLines >= 0 && active.isEmpty() && number > showUntil && nextStart - number > contextLines) {
+            if (next == rows.size()) {
+                break; // Nothing left to show
+            }
+            continue;
+        }
+
+        if (lastShown > 0 && number > lastShown + 1) {
+            out += gap();
+        }
+        out += sourceLine(number, QString::fromUtf8(raw), results, active);
+        for (int i = firstStarting; i < active.size(); ++i) {
+            out += annotation(results, active[i]);
+        }
+        lastShown = number;
+    }
+
+    // Findings reported past the end of the file
+    for (; next < rows.size(); ++next) {
+        out += annotation(results, rows[next]);
+    }
+    return out + fileFooter();
+}
+
+/**
+ * @brief Renders one source line with the code of its findings marked.
+ * @param number The line number (1-based).
+ * @param text The text of the line.
+ * @param results The findings.
+ * @param active The findings covering the line.
+ * @return The rendered line.
+ */
+QByteArray ErrorHighlighter::sourceLine(int number, const QString& text, const FindingSnapshot& results,
+                                        const QVector<int>& active) const {
+    // Highest severity marked on every code unit, -1 where nothing is
+    QVector<qint8> marks;
+    for (int row : active) {
+        if (marks.isEmpty()) {
+            marks.fill(-1, text.size());
+        }
+        const AuditResult::ColumnKind kind = results->columnKind(row);
+        int first = 0;
+        if (results->line(row) == number && results->column(row) > 0) {
+            first = LineIndex::columnOffset(text.constData(), text.size(), results->column(row), kind);
+        }
+        int last = text.size();
+        if (qMax(results->endLine(row), results->line(row)) == number && results->endColumn(row) > 0 &&
+            (results->line(row) != number || results->endColumn(row) > results->column(row))) {
+            last = LineIndex::columnOffset(text.constData(), text.size(), results->endColumn(row), kind);
+        }
+        last = qMax(last, qMin(first + 1, text.size()));
+        for (int i = first; i < last; ++i) {
+            marks[i] = qMax(marks[i], qint8(results->severity(row)));
+        }
+    }
+
+    QByteArray out;
+    if (format == Html) {
+        out += QString("<span class=\"number\">%1 </span>").arg(number, 6).toUtf8();
+    } else {
+        out += QByteArray(AnsiDim) + QString("%1 | ").arg(number, 6).toUtf8() + AnsiReset;
+    }
+
+    int start = 0;
+    while (start < text.size()) {
+        const int severity = marks.isEmpty() ? -1 : marks[start];
+        int end = start + 1;
+        while (end < text.size() && (marks.isEmpty() ? -1 : marks[end]) == severity) {
+            ++end;
+        }
+        QString run = text.mid(start, end - start);
+        if (format == Html) {
+            run = run.toHtmlEscaped();
+            if (severity >= 0) {
+                run = QString("<mark class=\"%1\">%2</mark>").arg(severityName(severity), run);
             }
+            out += run.toUtf8();
+        } else if (severity >= 0) {
+            out += QByteArray(ansiMarkColor(severity)) + run.toUtf8() + AnsiReset;
+        } else {
+            out += run.toUtf8();
         }
+        start = end;
     }
-}
\ No newline at end of file
+    return out + "\n";
+}
+
+/**
+ * @brief Renders the description of a finding.
+ * @param results The findings.
+ * @param row The finding.
+ * @return The rendered description.
+ */
+QByteArray ErrorHighlighter::annotation(const FindingSnapshot& results, int row) const {
+    const int severity = results->severity(row);
+    QString location = QString::number(results->line(row));
+    if (results->column(row) > 0) {
+        location += ':' + QString::number(results->column(row));
+    }
+    QString rule = results->ruleId(row).isEmpty() ? QString() : QString(" [%1]").arg(results->ruleId(row));
+    QString message = findingMessage(results, row);
+
+    if (format == Html) {
+        return QString("<span class=\"note %1\">%2 %1 at %3%4: %5</span>")
+            .arg(severityName(severity), QString(7, ' '), location, rule.toHtmlEscaped(), message.toHtmlEscaped())
+            .toUtf8();
+    }
+    return QByteArray(AnsiDim) + "       | " + AnsiReset + ansiTextColor(severity) + severityName(severity) +
+           AnsiReset + QString(" at %1%2: %3\n").arg(location, rule, message).toUtf8();
+}
+
+/**
+ * @brief Renders the marker of lines left out between two shown lines.
+ * @return The rendered marker.
+ */
+QByteArray ErrorHighlighter::gap() const {
+    if (format == Html) {
+        return "<span class=\"gap\">   ...</span>\n";
+    }
+    return QByteArray(AnsiDim) + "   ..." + AnsiReset + "\n";
+}
+
+/**
+ * @brief Renders the start of the report.
+ * @param title The title of the report.
+ * @param fileCount The number of files in the report.
+ * @param findingCount The number of findings in the report.
+ * @return The rendered header.
+ */
+QByteArray ErrorHighlighter::reportHeader(const QString& title, int fileCount, int findingCount) const {
+    QString summary = QString("%1 findings in %2 files").arg(findingCount).arg(fileCount);
+    if (format == Html) {
+        return QString("<!DOCTYPE html>\n<html>\n<head>\n<meta charset=\"utf-8\">\n<title>%1</title>\n"
+                       "<style>%2</style>\n</head>\n<body>\n<h1>%1</h1>\n<p>%3</p>\n")
+            .arg(title.toHtmlEscaped(), QString(HtmlStyle), summary)
+            .toUtf8();
+    }
+    return QByteArray(AnsiBold) + title.toUtf8() + AnsiReset + "\n" + summary.toUtf8() + "\n\n";
+}
+
+/**
+ * @brief Renders the end of the report.
+ * @return The rendered footer.
+ */
+QByteArray ErrorHighlighter::reportFooter() const {
+    return format == Html ? "</body>\n</html>\n" : "";
+}
+
+/**
+ * @brief Renders the start of the section of a file.
+ * @param path The source file.
+ * @param findingCount The number of findings in the file.
+ * @return The rendered header.
+ */
+QByteArray ErrorHighlighter::fileHeader(const QString& path, int findingCount) const {
+    QString count = QString("%1 finding%2").arg(findingCount).arg(findingCount == 1 ? "" : "s");
+    if (format == Html) {
+        return QString("<section>\n<h2>%1 <span class=\"count\">%2</span></h2>\n<pre>")
+            .arg(path.toHtmlEscaped(), count)
+            .toUtf8();
+    }
+    return QByteArray(AnsiBold) + path.toUtf8() + AnsiReset + " (" + count.toUtf8() + ")\n";
+}
+
+/**
+ * @brief Renders the end of the section of a file.
+ * @return The rendered footer.
+ */
+QByteArray ErrorHighlighter::fileFooter() const {
+    return format == Html ? "</pre>\n</section>\n" : "\n";
+}
@@ -59,6 +59,15 @@ void FileTreeView::setRootPath(const QString& path) {
     setRootIndex(model->index(path));
 }
 
+/**
+ * @brief Returns the root directory shown in the file tree view.
+ * 
+ * @return The root directory path.
+ */
+QString FileTreeView::rootPath() const {
+    return model->rootPath();
+}
+
 /**
  * @brief Handles mouse release events to detect file selection.
  * 
@@ -0,0 +1,122 @@
+#include "../includes/find_bar.hpp"
+#include <QHBoxLayout>
+
+/**
+ * @class FindBar
+ * @brief Inline search bar shown below the editor.
+ *
+ * Replaces the modal find dialog: the query is emitted on every keystroke so
+ * the search runs as the user types, Enter and Shift+Enter move between
+ * matches and Escape closes the bar.
+ */
+
+FindBar::FindBar(QWidget* parent)
+    : QWidget(parent)
+    , searchEdit(new QLineEdit(this))
+    , caseCheckBox(new QCheckBox("Match case", this))
+    , regexCheckBox(new QCheckBox("Regex", this))
+    , statusLabel(new QLabel(this))
+    , previousButton(new QToolButton(this))
+    , nextButton(new QToolButton(this))
+    , closeButton(new QToolButton(this))
+{
+    setupUi();
+}
+
+void FindBar::setupUi()
+{
+    QHBoxLayout* layout = new QHBoxLayout(this);
+    layout->setContentsMargins(5, 3, 5, 3);
+    layout->setSpacing(5);
+
+    searchEdit->setPlaceholderText("Enter text to find...");
+    searchEdit->setClearButtonEnabled(true);
+    searchEdit->installEventFilter(this);
+
+    previousButton->setArrowType(Qt::UpArrow);
+    previousButton->setToolTip("Previous match (Shift+Enter)");
+    nextButton->setArrowType(Qt::DownArrow);
+    nextButton->setToolTip("Next match (Enter)");
+    closeButton->setText("✕");
+    closeButton->setToolTip("Close (Escape)");
+    statusLabel->setMinimumWidth(120);
+
+    layout->addWidget(searchEdit, 1);
+    layout->addWidget(caseCheckBox);
+    layout->addWidget(regexCheckBox);
+    layout->addWidget(previousButton);
+    layout->addWidget(nextButton);
+    layout->addWidget(statusLabel);
+    layout->addWidget(closeButton);
+
+    connect(searchEdit, &QLineEdit::textChanged, this, &FindBar::queryChanged);
+    connect(caseCheckBox, &QCheckBox::toggled, this, &FindBar::queryChanged);
+    connect(regexCheckBox, &QCheckBox::toggled, this, &FindBar::queryChanged);
+    connect(previousButton, &QToolButton::clicked, this, &FindBar::findPrevious);
+    connect(nextButton, &QToolButton::clicked, this, &FindBar::findNext);
+    connect(closeButton, &QToolButton::clicked, this, [this]() {
+        hide();
+        emit closed();
+    });
+}
+
+/**
+ * @brief Returns the query currently entered in the bar.
+ * @return The search pattern and options.
+ */
+SearchEngine::Query FindBar::query() const
+{
+    SearchEngine::Query query;
+    query.pattern = searchEdit->text();
+    query.caseSensitive = caseCheckBox->isChecked();
+    query.regularExpression = regexCheckBox->isChecked();
+    return query;
+}
+
+/**
+ * @brief Shows the bar and focuses the search field with its text selected.
+ */
+void FindBar::activate()
+{
+    show();
+    searchEdit->setFocus();
+    searchEdit->selectAll();
+}
+
+/**
+ * @brief Shows the match count or an error next to the buttons.
+ * @param status The text to show.
+ * @param error True to show the text as an error.
+ */
+void FindBar::setStatus(const QString& status, bool error)
+{
+    statusLabel->setText(status);
+    statusLabel->setStyleSheet(error ? "QLabel { color: #c0392b; }" : QString());
+}
+
+/**
+ * @brief Handles Enter, Shift+Enter and Escape in the search field.
+ * @param obj The object receiving the event.
+ * @param event The event to be processed.
+ * @return True if the event was handled, otherwise false.
+ */
+bool FindBar::eventFilter(QObject* obj, QEvent* event)
+{
+    if (obj == searchEdit && event->type() == QEvent::KeyPress) {
+        QKeyEvent* keyEvent = static_cast<QKeyEvent*>(event);
+        if (keyEvent->key() == Qt::Key_Return || keyEvent->key() == Qt::Key_Enter) {
+            if (keyEvent->modifiers() & Qt::ShiftModifier) {
+                emit findPrevious();
+            } else {
+                emit findNext();
+            }
+            return true;
+        }
+        if (keyEvent->key() == Qt::Key_Escape) {
+            hide();
+            emit closed();
+            return true;
+        }
+    }
+    return QWidget::eventFilter(obj, event);
+}
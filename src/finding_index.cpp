@@ -0,0 +1,344 @@
+#include "../includes/finding_index.hpp"
+#include <QDir>
+#include <QFileInfo>
+#include <QUrl>
+#include <algorithm>
+#include <climits>
+
+/**
+ * @class FindingIndex
+ * @brief Per-file interval index over audit findings.
+ *
+ * File paths and rule IDs are interned to small integer IDs. For every file
+ * the findings are kept as line intervals sorted by start line and augmented
+ * into an implicit interval tree (each inner node stores the largest end line
+ * of its subtree), so "which findings cover these lines" is answered in
+ * O(log n + k) instead of scanning every result. Rows returned by the queries
+ * are indices into the FindingStore the index was built from.
+ */
+
+/**
+ * @brief Rebuilds the index from a snapshot of findings.
+ *
+ * Findings without location information are not indexed.
+ *
+ * @param findings The findings to index.
+ */
+void FindingIndex::build(const FindingStore& findings) {
+    clear();
+
+    for (int row = 0; row < findings.size(); ++row) {
+        if (!findings.hasLocationInfo(row)) {
+            continue;
+        }
+
+        Interval interval;
+        interval.start = findings.line(row);
+        interval.end = qMax(findings.endLine(row), findings.line(row)) + 1;
+        interval.maxEnd = interval.end;
+        interval.row = row;
+        interval.ruleId = internRule(findings.ruleId(row));
+        interval.severity = findings.severity(row);
+
+        int id = internFile(findings.filePath(row));
+        files[id].intervals.append(interval);
+    }
+
+    for (FileIntervals& file : files) {
+        std::sort(file.intervals.begin(), file.intervals.end(),
+                  [](const Interval& a, const Interval& b) {
+                      return a.start < b.start || (a.start == b.start && a.row < b.row);
+                  });
+        file.maxLevel = buildTree(file.intervals);
+    }
+}
+
+/**
+ * @brief Removes every finding and interned ID from the index.
+ */
+void FindingIndex::clear() {
+    filePaths.clear();
+    fileIds.clear();
+    fileIdsByName.clear();
+    ruleIds.clear();
+    files.clear();
+}
+
+/**
+ * @brief Normalizes a SARIF artifact URI or a local path for comparison.
+ * @param path The path or "file://" URI.
+ * @return The cleaned local path.
+ */
+QString FindingIndex::normalizePath(const QString& path) {
+    if (path.startsWith("file:")) {
+        return QDir::cleanPath(QUrl(path).toLocalFile());
+    }
+    return QDir::cleanPath(path);
+}
+
+/**
+ * @brief Looks up the interned ID of a file.
+ *
+ * SARIF reports often use paths relative to the analysis directory, so when
+ * there is no exact match the lookup falls back to files with the same name:
+ * the one with the longest path that is a suffix of the requested path, or
+ * the only one. Findings of a file are never shown in another file of the
+ * same name, so an ambiguous name matches nothing.
+ *
+ * @param path The file path to look up.
+ * @return The file ID, or -1 if the file has no findings or the name is ambiguous.
+ */
+int FindingIndex::fileId(const QString& path) const {
+    QString normalized = normalizePath(path);
+    auto exact = fileIds.constFind(normalized);
+    if (exact != fileIds.constEnd()) {
+        return exact.value();
+    }
+
+    QList<int> candidates = fileIdsByName.values(QFileInfo(normalized).fileName());
+    if (candidates.isEmpty()) {
+        return -1;
+    }
+    int best = -1;
+    for (int candidate : candidates) {
+        if (normalized.endsWith("/" + filePaths[candidate]) &&
+            (best < 0 || filePaths[candidate].size() > filePaths[best].size())) {
+            best = candidate;
+        }
+    }
+    if (best < 0 && candidates.size() == 1) {
+        best = candidates.first();
+    }
+    return best;
+}
+
+/**
+ * @brief Looks up the interned ID of a rule.
+ * @param rule The rule ID reported by the analysis tool.
+ * @return The interned rule ID, or -1 if no finding uses this rule.
+ */
+int FindingIndex::ruleId(const QString& rule) const {
+    return ruleIds.value(rule, -1);
+}
+
+/**
+ * @brief Returns the path of an interned file.
+ * @param fileId The file ID.
+ * @return The normalized path, or an empty string for an unknown ID.
+ */
+QString FindingIndex::filePath(int fileId) const {
+    return fileId >= 0 && fileId < filePaths.size() ? filePaths[fileId] : QString();
+}
+
+/**
+ * @brief Returns the number of findings indexed for a file.
+ * @param fileId The file ID.
+ * @return The number of findings.
+ */
+int FindingIndex::findingCount(int fileId) const {
+    return fileId >= 0 && fileId < files.size() ? files[fileId].intervals.size() : 0;
+}
+
+/**
+ * @brief Returns the findings overlapping a range of lines.
+ * @param fileId The file ID.
+ * @param firstLine The first line of the range (1-based, inclusive).
+ * @param lastLine The last line of the range (1-based, inclusive).
+ * @return The result rows, ordered by start line.
+ */
+QVector<int> FindingIndex::findingsInRange(int fileId, int firstLine, int lastLine) const {
+    return query(fileId, firstLine, lastLine, AuditResult::Info);
+}
+
+/**
+ * @brief Returns the findings covering a single line.
+ * @param fileId The file ID.
+ * @param line The line number (1-based).
+ * @return The result rows, ordered by start line.
+ */
+QVector<int> FindingIndex::findingsAtLine(int fileId, int line) const {
+    return query(fileId, line, line, AuditResult::Info);
+}
+
+/**
+ * @brief Returns the findings overlapping a range of lines, filtered by severity and rule.
+ *
+ * Walks the implicit interval tree, skipping every subtree whose largest end
+ * line lies before the range. Small subtrees are scanned linearly.
+ *
+ * @param fileId The file ID.
+ * @param firstLine The first line of the range (1-based, inclusive).
+ * @param lastLine The last line of the range (1-based, inclusive).
+ * @param minSeverity The lowest severity to report.
+ * @param ruleId An interned rule ID to restrict the results to, or -1 for any rule.
+ * @return The result rows, ordered by start line.
+ */
+QVector<int> FindingIndex::query(int fileId, int firstLine, int lastLine,
+                                 AuditResult::Severity minSeverity, int ruleId) const {
+    QVector<int> matches;
+    if (fileId < 0 || fileId >= files.size() || files[fileId].maxLevel < 0) {
+        return matches;
+    }
+
+    const QVector<Interval>& intervals = files[fileId].intervals;
+    const int count = intervals.size();
+    const int start = firstLine;
+    const int end = lastLine < INT_MAX ? lastLine + 1 : INT_MAX;
+
+    auto accept = [&](int i) {
+        const Interval& interval = intervals[i];
+        if (start < interval.end && interval.severity >= minSeverity &&
+            (ruleId < 0 || interval.ruleId == ruleId)) {
+            matches.append(i);
+        }
+    };
+
+    struct Node {
+        int index;
+        int level;
+        bool leftVisited;
+    };
+    Node stack[64];
+    int top = 0;
+    const int maxLevel = files[fileId].maxLevel;
+    stack[top++] = {(1 << maxLevel) - 1, maxLevel, false};
+
+    while (top > 0) {
+        Node node = stack[--top];
+        if (node.level <= 3) {
+            // Small subtree: scan it linearly
+            int first = node.index >> node.level << node.level;
+            int last = qMin(first + (1 << (node.level + 1)) - 1, count);
+            for (int i = first; i < last && intervals[i].start < end; ++i) {
+                accept(i);
+            }
+        } else if (!node.leftVisited) {
+            int left = node.index - (1 << (node.level - 1));
+            stack[top++] = {node.index, node.level, true};
+            if (left >= count || intervals[left].maxEnd > start) {
+                stack[top++] = {left, node.level - 1, false};
+            }
+        } else if (node.index < count && intervals[node.index].start < end) {
+            accept(node.index);
+            stack[top++] = {node.index + (1 << (node.level - 1)), node.level - 1, false};
+        }
+    }
+
+    // Array order is start-line order
+    std::sort(matches.begin(), matches.end());
+    for (int& match : matches) {
+        match = intervals[match].row;
+    }
+    return matches;
+}
+
+/**
+ * @brief Finds the first finding starting after a line.
+ * @param fileId The file ID.
+ * @param line The current line (1-based).
+ * @return The result row, or -1 if there is no finding after the line.
+ */
+int FindingIndex::nextFinding(int fileId, int line) const {
+    if (fileId < 0 || fileId >= files.size()) {
+        return -1;
+    }
+    const QVector<Interval>& intervals = files[fileId].intervals;
+    auto it = std::upper_bound(intervals.begin(), intervals.end(), line,
+                               [](int value, const Interval& interval) {
+                                   return value < interval.start;
+                               });
+    return it != intervals.end() ? it->row : -1;
+}
+
+/**
+ * @brief Finds the last finding starting before a line.
+ * @param fileId The file ID.
+ * @param line The current line (1-based).
+ * @return The result row, or -1 if there is no finding before the line.
+ */
+int FindingIndex::previousFinding(int fileId, int line) const {
+    if (fileId < 0 || fileId >= files.size()) {
+        return -1;
+    }
+    const QVector<Interval>& intervals = files[fileId].intervals;
+    auto it = std::lower_bound(intervals.begin(), intervals.end(), line,
+                               [](const Interval& interval, int value) {
+                                   return interval.start < value;
+                               });
+    return it != intervals.begin() ? (it - 1)->row : -1;
+}
+
+/**
+ * @brief Interns a file path.
+ * @param path The path or URI reported by the analysis tool.
+ * @return The file ID.
+ */
+int FindingIndex::internFile(const QString& path) {
+    QString normalized = normalizePath(path);
+    auto it = fileIds.constFind(normalized);
+    if (it != fileIds.constEnd()) {
+        return it.value();
+    }
+
+    int id = filePaths.size();
+    filePaths.append(normalized);
+    fileIds.insert(normalized, id);
+    fileIdsByName.insert(QFileInfo(normalized).fileName(), id);
+    files.append(FileIntervals{QVector<Interval>(), -1});
+    return id;
+}
+
+/**
+ * @brief Interns a rule ID.
+ * @param rule The rule ID reported by the analysis tool.
+ * @return The interned rule ID.
+ */
+int FindingIndex::internRule(const QString& rule) {
+    auto it = ruleIds.constFind(rule);
+    if (it != ruleIds.constEnd()) {
+        return it.value();
+    }
+    int id = ruleIds.size();
+    ruleIds.insert(rule, id);
+    return id;
+}
+
+/**
+ * @brief Computes the subtree maxima of an implicit interval tree.
+ *
+ * The sorted array is viewed as a binary tree where leaves sit at even
+ * indices and a node at level k has its k lowest bits set.
+ *
+ * @param intervals The intervals, sorted by start line.
+ * @return The level of the root node, or -1 for an empty array.
+ */
+int FindingIndex::buildTree(QVector<Interval>& intervals) {
+    const int count = intervals.size();
+    if (count == 0) {
+        return -1;
+    }
+
+    int lastIndex = 0;
+    int lastMax = 0;
+    for (int i = 0; i < count; i += 2) {
+        lastIndex = i;
+        lastMax = intervals[i].maxEnd = intervals[i].end;
+    }
+
+    int level = 1;
+    for (; (1 << level) <= count; ++level) {
+        const int half = 1 << (level - 1);
+        const int step = half << 2;
+        for (int i = (half << 1) - 1; i < count; i += step) {
+            int leftMax = intervals[i - half].maxEnd;
+            int rightMax = i + half < count ? intervals[i + half].maxEnd : lastMax;
+            intervals[i].maxEnd = qMax(intervals[i].end, qMax(leftMax, rightMax));
+        }
+        // Move to the parent of the last node, which may lie past the array end
+        lastIndex = (lastIndex >> level & 1) ? lastIndex - half : lastIndex + half;
+        if (lastIndex < count && intervals[lastIndex].maxEnd > lastMax) {
+            lastMax = intervals[lastIndex].maxEnd;
+        }
+    }
+    return level - 1;
+}
@@ -0,0 +1,235 @@
+#include "../includes/finding_remapper.hpp"
+#include "../includes/finding_index.hpp"
+#include <algorithm>
+
+namespace {
+// Beyond this many changed lines the diff is abandoned and everything is stale
+const int MaxDiffEdits = 4000;
+}
+
+/**
+ * @class FindingRemapper
+ * @brief Moves cached findings along with the edits made since they were analysed.
+ *
+ * The content ctrace analysed is diffed against the current content. Findings
+ * on unchanged lines are shifted to their new line (and column, when only the
+ * indentation changed), findings on deleted lines are dropped, and findings
+ * on modified lines are kept but marked stale.
+ */
+
+/**
+ * @brief Diffs the analysed content against the current content.
+ * @param analysedLines The lines of the file as ctrace analysed it.
+ * @param currentLines The current lines of the file.
+ */
+FindingRemapper::FindingRemapper(const QStringList& analysedLines, const QStringList& currentLines)
+    : analysedLines(analysedLines)
+    , currentLines(currentLines)
+    , valid(false)
+    , codeChanged(false)
+{
+    valid = LineDiff::compute(LineDiff::hashLines(analysedLines), LineDiff::hashLines(currentLines),
+                              MaxDiffEdits, hunks);
+    if (!valid) {
+        codeChanged = true;
+        return;
+    }
+
+    // Cumulative line shift after each hunk, and which hunks touch actual code
+    int delta = 0;
+    lineDeltas.append(0);
+    for (const LineDiff::Hunk& hunk : hunks) {
+        delta += hunk.newCount - hunk.oldCount;
+        lineDeltas.append(delta);
+
+        bool code = false;
+        for (int i = 0; i < hunk.oldCount && !code; ++i) {
+            code = !analysedLines[hunk.oldStart + i].trimmed().isEmpty();
+        }
+        for (int i = 0; i < hunk.newCount && !code; ++i) {
+            code = !currentLines[hunk.newStart + i].trimmed().isEmpty();
+        }
+        codeHunks.append(code);
+        codeChanged = codeChanged || code;
+    }
+}
+
+/**
+ * @brief Checks whether code changed within the lines of a finding of a file.
+ *
+ * Edits elsewhere in the file only move the findings, so they do not call
+ * for a new analysis. Lines inserted between two lines of a finding count
+ * as a change of that finding. If the diff was abandoned, any finding of
+ * the file may have changed.
+ *
+ * @param findings The findings as reported for the analysed content.
+ * @param file The path of the edited file.
+ * @return True if a hunk changing code overlaps the analysed lines of a finding.
+ */
+bool FindingRemapper::changesFindings(const FindingSnapshot& findings, const QString& file) const {
+    if (!codeChanged) {
+        return false;
+    }
+    FindingIndex index;
+    index.build(*findings);
+    const int fileId = index.fileId(file);
+    if (index.findingCount(fileId) == 0) {
+        return false;
+    }
+    if (!valid) {
+        return true;
+    }
+
+    for (int i = 0; i < hunks.size(); ++i) {
+        if (!codeHunks[i]) {
+            continue;
+        }
+        const LineDiff::Hunk& hunk = hunks[i];
+        if (hunk.oldCount > 0) {
+            if (!index.findingsInRange(fileId, hunk.oldStart + 1, hunk.oldStart + hunk.oldCount).isEmpty()) {
+                return true;
+            }
+            continue;
+        }
+
+        // Pure insertion between analysed lines oldStart and oldStart + 1 (1-based)
+        for (int row : index.findingsInRange(fileId, hunk.oldStart, hunk.oldStart + 1)) {
+            if (findings->line(row) <= hunk.oldStart && findings->endLine(row) > hunk.oldStart) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Relocates the findings of a file to the current content.
+ *
+ * Findings of other files are returned unchanged. If the diff was abandoned,
+ * every finding of the file is marked stale at its original location.
+ *
+ * @param findings The findings as reported for the analysed content.
+ * @param file The path of the edited file.
+ * @return The relocated snapshot.
+ */
+FindingSnapshot FindingRemapper::remap(const FindingSnapshot& findings, const QString& file) const {
+    FindingIndex index;
+    index.build(*findings);
+    const QString path = index.filePath(index.fileId(file));
+    if (path.isEmpty()) {
+        return findings;
+    }
+
+    return findings->relocated([&](int row, FindingStore::Location& location) {
+        if (!findings->hasLocationInfo(row) || FindingIndex::normalizePath(findings->filePath(row)) != path) {
+            return true;
+        }
+        if (!valid) {
+            location.stale = true;
+            return true;
+        }
+
+        int line = 0;
+        int column = 0;
+        bool touched = false;
+        if (!mapPosition(location.line, location.column, line, column, touched)) {
+            return false;
+        }
+
+        int endLine = line;
+        int endColumn = location.endColumn;
+        bool endTouched = false;
+        if (!mapPosition(location.endLine, location.endColumn, endLine, endColumn, endTouched) ||
+            endLine < line) {
+            endLine = line;
+            endColumn = location.endColumn + (column - location.column);
+        }
+
+        location.line = line;
+        location.column = column;
+        location.endLine = endLine;
+        location.endColumn = endColumn;
+        location.stale = location.stale || touched || endTouched;
+        return true;
+    });
+}
+
+/**
+ * @brief Maps a position of the analysed content to the current content.
+ * @param line The analysed line (1-based).
+ * @param column The analysed column (1-based, 0 if unknown).
+ * @param newLine Receives the current line.
+ * @param newColumn Receives the current column.
+ * @param touched Set to true if the line itself was modified.
+ * @return False if the line was deleted.
+ */
+bool FindingRemapper::mapPosition(int line, int column, int& newLine, int& newColumn, bool& touched) const {
+    const int index = line - 1;
+    touched = false;
+    if (index < 0 || index >= analysedLines.size()) {
+        return false;
+    }
+
+    // Number of hunks starting at or before this line
+    int count = std::upper_bound(hunks.begin(), hunks.end(), index,
+                                 [](int value, const LineDiff::Hunk& hunk) {
+                                     return value < hunk.oldStart;
+                                 }) - hunks.begin();
+
+    if (count > 0) {
+        const LineDiff::Hunk& hunk = hunks[count - 1];
+        if (index < hunk.oldStart + hunk.oldCount) {
+            // The line was replaced: pair it with the same line of the new range if any
+            int offset = index - hunk.oldStart;
+            if (offset >= hunk.newCount) {
+                return false;
+            }
+
+            const QString& oldText = analysedLines[index];
+            const QString& newText = currentLines[hunk.newStart + offset];
+            int prefix = 0;
+            int maxCommon = qMin(oldText.length(), newText.length());
+            while (prefix < maxCommon && oldText[prefix] == newText[prefix]) {
+                ++prefix;
+            }
+            int suffix = 0;
+            while (suffix < maxCommon - prefix &&
+                   oldText[oldText.length() - 1 - suffix] == newText[newText.length() - 1 - suffix]) {
+                ++suffix;
+            }
+
+            newLine = hunk.newStart + offset + 1;
+            if (column - 1 >= oldText.length() - suffix) {
+                newColumn = column + (newText.length() - oldText.length());
+            } else {
+                newColumn = qMin(column, newText.length() + 1);
+            }
+            touched = true;
+            return true;
+        }
+    }
+
+    newLine = line + lineDeltas[count];
+    newColumn = column;
+    if (column > 0) {
+        const QString& oldText = analysedLines[index];
+        const QString& newText = currentLines[newLine - 1];
+        if (oldText != newText) {
+            newColumn = qMax(1, column + leadingWhitespace(newText) - leadingWhitespace(oldText));
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Counts the whitespace characters at the start of a line.
+ * @param line The line text.
+ * @return The indentation width in characters.
+ */
+int FindingRemapper::leadingWhitespace(const QString& line) {
+    int count = 0;
+    while (count < line.length() && line[count].isSpace()) {
+        ++count;
+    }
+    return count;
+}
@@ -0,0 +1,292 @@
+#include "../includes/finding_store.hpp"
+
+/**
+ * @class FindingStore
+ * @brief Immutable, column-oriented storage for audit findings.
+ *
+ * Findings are stored as parallel arrays (packed severity, line and column
+ * numbers, string IDs) instead of a list of AuditResult objects, and every
+ * string is interned once per store. A store is never modified after it has
+ * been built and is handed around as a FindingSnapshot, a reference-counted
+ * pointer, so the cache, the audit service, the result views and the editor
+ * all share the same data without copying it.
+ *
+ * Every finding carries the fingerprint computed by the parser. A store never
+ * holds two findings with the same fingerprint: when the same issue is
+ * reported twice, by several tools or several shards, only the first report
+ * is kept.
+ */
+
+/**
+ * @brief Constructs an empty store.
+ */
+FindingStore::FindingStore() {
+    issueOffsets.append(0);
+}
+
+/**
+ * @brief Builds a snapshot from a list of audit results.
+ * @param results The audit results to store.
+ * @return The shared, immutable snapshot.
+ */
+FindingSnapshot FindingStore::fromResults(const QList<AuditResult>& results) {
+    QSharedPointer<FindingStore> store(new FindingStore());
+    store->severities.reserve(results.size());
+    store->lines.reserve(results.size());
+    store->columns.reserve(results.size());
+    store->endLines.reserve(results.size());
+    store->endColumns.reserve(results.size());
+    store->fingerprints.reserve(results.size());
+    store->fingerprintSet.reserve(results.size());
+
+    for (const AuditResult& result : results) {
+        if (store->accept(result.getFingerprint())) {
+            store->append(result);
+        }
+    }
+    return store;
+}
+
+/**
+ * @brief Concatenates several snapshots into one.
+ *
+ * A single non-empty part is returned as is, so no data is copied in the
+ * common case of one analysis run. Findings already present in an earlier
+ * part are dropped.
+ *
+ * @param parts The snapshots to concatenate, in order.
+ * @return The combined snapshot.
+ */
+FindingSnapshot FindingStore::concat(const QList<FindingSnapshot>& parts) {
+    QList<FindingSnapshot> nonEmpty;
+    for (const FindingSnapshot& part : parts) {
+        if (part && !part->isEmpty()) {
+            nonEmpty.append(part);
+        }
+    }
+    if (nonEmpty.isEmpty()) {
+        return empty();
+    }
+    if (nonEmpty.size() == 1) {
+        return nonEmpty.first();
+    }
+
+    int total = 0;
+    for (const FindingSnapshot& part : nonEmpty) {
+        total += part->size();
+    }
+
+    QSharedPointer<FindingStore> store(new FindingStore());
+    store->fingerprintSet.reserve(total);
+    for (const FindingSnapshot& part : nonEmpty) {
+        for (int row = 0; row < part->size(); ++row) {
+            if (store->accept(part->fingerprints[row])) {
+                store->appendRow(*part, row);
+            }
+        }
+    }
+    return store;
+}
+
+/**
+ * @brief Returns a snapshot without any finding.
+ * @return The empty snapshot.
+ */
+FindingSnapshot FindingStore::empty() {
+    static const FindingSnapshot emptyStore(new FindingStore());
+    return emptyStore;
+}
+
+/**
+ * @brief Returns the findings of this store that another store does not have.
+ *
+ * Compares the fingerprints, so findings that only moved between two runs
+ * are not reported as new.
+ *
+ * @param other The store to compare with, typically the previous run.
+ * @return The rows of this store, in order.
+ */
+QVector<int> FindingStore::rowsNotIn(const FindingStore& other) const {
+    QVector<int> rows;
+    for (int row = 0; row < size(); ++row) {
+        if (fingerprints[row] == 0 || !other.contains(fingerprints[row])) {
+            rows.append(row);
+        }
+    }
+    return rows;
+}
+
+/**
+ * @brief Returns the issue lines of a finding.
+ * @param row The finding index.
+ * @return The issue lines, in the order they were added.
+ */
+QStringList FindingStore::issues(int row) const {
+    QStringList result;
+    for (quint32 i = issueOffsets[row]; i < issueOffsets[row + 1]; ++i) {
+        result.append(strings[issueIds[i]]);
+    }
+    return result;
+}
+
+/**
+ * @brief Returns the full message of a finding (all issue lines joined).
+ * @param row The finding index.
+ * @return The message.
+ */
+QString FindingStore::message(int row) const {
+    return issues(row).join("\n");
+}
+
+/**
+ * @brief Generates the summary of a finding, as AuditResult::getSummary() does.
+ * @param row The finding index.
+ * @return The summary string.
+ */
+QString FindingStore::summary(int row) const {
+    return QString("File: %1\nIssues found: %2").arg(fileName(row)).arg(issueCount(row));
+}
+
+/**
+ * @brief Materializes a single finding as an AuditResult.
+ * @param row The finding index.
+ * @return A standalone AuditResult with the same content.
+ */
+AuditResult FindingStore::toResult(int row) const {
+    AuditResult result(fileName(row));
+    result.setFilePath(filePath(row));
+    result.setLine(line(row));
+    result.setColumn(column(row));
+    result.setEndLine(endLine(row));
+    result.setEndColumn(endColumn(row));
+    result.setColumnKind(columnKind(row));
+    result.setRuleId(ruleId(row));
+    result.setToolName(toolName(row));
+    result.setLevel(level(row));
+    result.setFingerprint(fingerprint(row));
+    for (quint32 i = issueOffsets[row]; i < issueOffsets[row + 1]; ++i) {
+        result.addIssue(strings[issueIds[i]]);
+    }
+    return result;
+}
+
+/**
+ * @brief Builds a copy of the store with updated finding locations.
+ *
+ * The callback receives the current location of every finding and may
+ * change it, or return false to drop the finding. The string table is shared
+ * with this store, so only the numeric columns are rebuilt.
+ *
+ * @param relocate Called once per finding, in row order.
+ * @return The relocated snapshot.
+ */
+FindingSnapshot FindingStore::relocated(const std::function<bool(int row, Location& location)>& relocate) const {
+    QSharedPointer<FindingStore> store(new FindingStore());
+    store->strings = strings;
+    store->stringIds = stringIds;
+
+    for (int row = 0; row < size(); ++row) {
+        Location location{lines[row], columns[row], endLines[row], endColumns[row], isStale(row)};
+        if (!relocate(row, location)) {
+            continue;
+        }
+
+        store->severities.append(severities[row]);
+        store->lines.append(location.line);
+        store->columns.append(location.column);
+        store->endLines.append(location.endLine);
+        store->endColumns.append(location.endColumn);
+        store->fileNameIds.append(fileNameIds[row]);
+        store->filePathIds.append(filePathIds[row]);
+        store->ruleIds.append(ruleIds[row]);
+        store->toolNameIds.append(toolNameIds[row]);
+        store->levelIds.append(levelIds[row]);
+        store->flags.append(quint8((flags[row] & ~StaleFlag) | (location.stale ? StaleFlag : 0)));
+        store->fingerprints.append(fingerprints[row]);
+        if (fingerprints[row] != 0) {
+            store->fingerprintSet.insert(fingerprints[row]);
+        }
+        for (quint32 i = issueOffsets[row]; i < issueOffsets[row + 1]; ++i) {
+            store->issueIds.append(issueIds[i]);
+        }
+        store->issueOffsets.append(store->issueIds.size());
+    }
+    return store;
+}
+
+/**
+ * @brief Returns the ID of a string, adding it to the string table if needed.
+ * @param value The string to intern.
+ * @return The string ID.
+ */
+quint32 FindingStore::intern(const QString& value) {
+    auto it = stringIds.constFind(value);
+    if (it != stringIds.constEnd()) {
+        return it.value();
+    }
+    quint32 id = strings.size();
+    strings.append(value);
+    stringIds.insert(value, id);
+    return id;
+}
+
+/**
+ * @brief Records a fingerprint and checks whether its finding should be added.
+ * @param fingerprint The fingerprint of the finding, 0 if it has none.
+ * @return False if a finding with the same fingerprint is already stored.
+ */
+bool FindingStore::accept(quint64 fingerprint) {
+    if (fingerprint == 0) {
+        return true;
+    }
+    int before = fingerprintSet.size();
+    fingerprintSet.insert(fingerprint);
+    return fingerprintSet.size() != before;
+}
+
+/**
+ * @brief Appends an audit result as a new row.
+ * @param result The audit result to append.
+ */
+void FindingStore::append(const AuditResult& result) {
+    severities.append(quint8(result.getSeverity()));
+    lines.append(result.getLine());
+    columns.append(result.getColumn());
+    endLines.append(result.getEndLine());
+    endColumns.append(result.getEndColumn());
+    fileNameIds.append(intern(result.getFileName()));
+    filePathIds.append(intern(result.getFilePath()));
+    ruleIds.append(intern(result.getRuleId()));
+    toolNameIds.append(intern(result.getToolName()));
+    levelIds.append(intern(result.getLevel()));
+    flags.append(quint8(result.getColumnKind() << ColumnKindShift));
+    fingerprints.append(result.getFingerprint());
+    for (const QString& issue : result.getIssues()) {
+        issueIds.append(intern(issue));
+    }
+    issueOffsets.append(issueIds.size());
+}
+
+/**
+ * @brief Appends a row copied from another store, re-interning its strings.
+ * @param source The store to copy from.
+ * @param row The row of the source store.
+ */
+void FindingStore::appendRow(const FindingStore& source, int row) {
+    severities.append(source.severities[row]);
+    lines.append(source.lines[row]);
+    columns.append(source.columns[row]);
+    endLines.append(source.endLines[row]);
+    endColumns.append(source.endColumns[row]);
+    fileNameIds.append(intern(source.fileName(row)));
+    filePathIds.append(intern(source.filePath(row)));
+    ruleIds.append(intern(source.ruleId(row)));
+    toolNameIds.append(intern(source.toolName(row)));
+    levelIds.append(intern(source.level(row)));
+    flags.append(source.flags[row]);
+    fingerprints.append(source.fingerprints[row]);
+    for (quint32 i = source.issueOffsets[row]; i < source.issueOffsets[row + 1]; ++i) {
+        issueIds.append(intern(source.strings[source.issueIds[i]]));
+    }
+    issueOffsets.append(issueIds.size());
+}
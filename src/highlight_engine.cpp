@@ -0,0 +1,465 @@
+#include "../includes/highlight_engine.hpp"
+#include "../includes/syntax_highlighter.hpp"
+#include <QRunnable>
+#include <QMetaObject>
+#include <QElapsedTimer>
+#include <QTextLayout>
+#include <QTextCursor>
+#include <QScrollBar>
+#include <functional>
+
+/**
+ * @class HighlightEngine
+ * @brief Colors the documents of an editor from tokens computed on a worker thread.
+ *
+ * When a document is shown for the first time, a snapshot of its text is
+ * tokenized line by line on a worker with the lexer chosen for the document
+ * (see LexerRegistry), and the token runs come back in batches tagged with
+ * the generation of the pass. The formats are applied from the UI thread in
+ * short idle slices: the blocks on screen first, then the rest of the
+ * document in order. A file therefore opens at once and its coloring fills
+ * in progressively. Edits made after the pass are highlighted synchronously,
+ * block by block, until the lexer state at the end of a block is unchanged,
+ * as QSyntaxHighlighter does. An edit during the pass does not restart it: the
+ * edited lines are lexed again when they are applied, the results still to
+ * come are moved to the current line numbers, and a line whose preceding
+ * state changed is lexed again instead of taking the tokens of the pass. A
+ * document without a lexer is plain text and costs nothing.
+ */
+
+namespace {
+const int BatchSize = 4096;
+const int IdleSliceMs = 8;
+
+// Only the start of longer lines is highlighted, so one line cannot stall a pass
+const int MaxHighlightedLineLength = 4096;
+
+typedef std::function<void(int, int, const QVector<HighlightEngine::LineTokens>&)> BatchCallback;
+
+class TokenizeTask : public QRunnable {
+public:
+    TokenizeTask(const QString& text, const Lexer* lexer, const QSharedPointer<QAtomicInt>& generation,
+                 const BatchCallback& batch, const std::function<void(int)>& finish)
+        : text(text), lexer(lexer), generation(generation), id(generation->loadAcquire()),
+          batch(batch), finish(finish) {}
+
+    void run() override {
+        QVector<HighlightEngine::LineTokens> lines;
+        lines.reserve(BatchSize);
+        int firstLine = 0;
+        int state = -1;
+        int start = 0;
+
+        // Blocks are separated by paragraph separators in the raw text
+        for (;;) {
+            if (cancelled()) {
+                return;
+            }
+            int end = text.indexOf(QChar::ParagraphSeparator, start);
+            bool last = end < 0;
+            if (last) {
+                end = text.size();
+            }
+
+            HighlightEngine::LineTokens line;
+            line.startState = state;
+            int length = qMin(end - start, MaxHighlightedLineLength);
+            state = lexer->tokenizeLine(text.mid(start, length), state, line.tokens);
+            line.state = state;
+            lines.append(line);
+
+            if (lines.size() == BatchSize || last) {
+                batch(id, firstLine, lines);
+                firstLine += lines.size();
+                lines.clear();
+            }
+            if (last) {
+                break;
+            }
+            start = end + 1;
+        }
+        finish(id);
+    }
+
+private:
+    bool cancelled() const {
+        return generation->loadAcquire() != id;
+    }
+
+    QString text;
+    const Lexer* lexer;
+    QSharedPointer<QAtomicInt> generation;
+    int id;
+    BatchCallback batch;
+    std::function<void(int)> finish;
+};
+}
+
+/**
+ * @brief Creates the engine of an editor and highlights its current document.
+ * @param editor The editor whose documents are highlighted.
+ */
+HighlightEngine::HighlightEngine(SourceEditor* editor)
+    : QObject(editor)
+    , textEditor(editor)
+    , lexer(nullptr)
+    , generation(new QAtomicInt(0))
+    , idleTimer(new QTimer(this))
+    , appliedCount(0)
+    , nextLine(0)
+    , running(false)
+    , applying(false)
+{
+    for (int kind = 0; kind < Lexer::TokenKindCount; ++kind) {
+        formats[kind] = SyntaxHighlighter::tokenFormat(Lexer::TokenKind(kind));
+    }
+
+    // A single pass at a time: a restarted pass waits for the cancelled one
+    pool.setMaxThreadCount(1);
+
+    idleTimer->setSingleShot(true);
+    idleTimer->setInterval(0);
+    connect(idleTimer, &QTimer::timeout, this, &HighlightEngine::applyPending);
+
+    // Newly exposed blocks are colored before the rest of the document
+    connect(textEditor->verticalScrollBar(), &QScrollBar::valueChanged, this, [this]() {
+        if (isHighlighting()) {
+            idleTimer->start();
+        }
+    });
+    attachDocument();
+}
+
+/**
+ * @brief Cancels the running pass and waits for the worker to stop.
+ */
+HighlightEngine::~HighlightEngine() {
+    cancel();
+    pool.waitForDone();
+}
+
+/**
+ * @brief Follows the document currently shown by the editor.
+ *
+ * Must be called again whenever the editor is given another document. A
+ * document with a lexer that has not been fully highlighted yet gets a new
+ * pass; the pass of the previous document is dropped and restarts when it is
+ * shown again.
+ */
+void HighlightEngine::attachDocument() {
+    QTextDocument* current = textEditor->document();
+    if (current == document) {
+        return;
+    }
+    if (document) {
+        disconnect(document, &QTextDocument::contentsChange, this, &HighlightEngine::contentsChange);
+    }
+    cancel();
+
+    document = current;
+    connect(document, &QTextDocument::contentsChange, this, &HighlightEngine::contentsChange);
+    DocumentState state = states.value(document);
+    lexer = state.lexer;
+    if (lexer && !state.highlighted) {
+        start();
+    }
+}
+
+/**
+ * @brief Sets the lexer of a document, nullptr for plain text.
+ *
+ * Expected to be called once, before the document is shown. The document is
+ * forgotten when it is deleted.
+ *
+ * @param document The document.
+ * @param lexer The lexer, owned by the caller and outliving the document.
+ */
+void HighlightEngine::setLexer(QTextDocument* document, const Lexer* lexer) {
+    if (!states.contains(document)) {
+        connect(document, &QObject::destroyed, this, [this, document]() { states.remove(document); });
+    }
+    states[document] = DocumentState{lexer, false};
+    if (document == this->document) {
+        cancel();
+        this->lexer = lexer;
+        if (lexer) {
+            start();
+        }
+    }
+}
+
+/**
+ * @brief Starts a pass over a snapshot of the current document.
+ */
+void HighlightEngine::start() {
+    cancel();
+    results.resize(document->blockCount());
+    status.fill(Pending, document->blockCount());
+    running = true;
+
+    auto batch = [this](int id, int firstLine, const QVector<LineTokens>& lines) {
+        QMetaObject::invokeMethod(this, [this, id, firstLine, lines]() { receive(id, firstLine, lines); },
+                                  Qt::QueuedConnection);
+    };
+    auto done = [this](int id) {
+        QMetaObject::invokeMethod(this, [this, id]() { finish(id); }, Qt::QueuedConnection);
+    };
+    pool.start(new TokenizeTask(document->toRawText(), lexer, generation, batch, done));
+}
+
+/**
+ * @brief Stops the running pass and drops the results not applied yet.
+ */
+void HighlightEngine::cancel() {
+    generation->fetchAndAddOrdered(1);
+    idleTimer->stop();
+    results.clear();
+    status.clear();
+    edits.clear();
+    appliedCount = 0;
+    nextLine = 0;
+    running = false;
+}
+
+/**
+ * @brief Stores a batch of token runs and schedules their application.
+ * @param id The generation of the pass that produced the batch.
+ * @param firstLine The line of the first entry, in the snapshot of the pass.
+ * @param lines The token runs, one per line.
+ */
+void HighlightEngine::receive(int id, int firstLine, const QVector<LineTokens>& lines) {
+    if (id != generation->loadAcquire() || !document) {
+        return;
+    }
+    for (int i = 0; i < lines.size(); ++i) {
+        int line = currentLine(firstLine + i);
+        if (line >= 0 && line < results.size() && status[line] == Pending) {
+            results[line] = lines[i];
+            status[line] = Received;
+        }
+    }
+    if (!idleTimer->isActive()) {
+        idleTimer->start();
+    }
+}
+
+/**
+ * @brief Marks the worker part of a pass as done.
+ * @param id The generation of the finished pass.
+ */
+void HighlightEngine::finish(int id) {
+    if (id != generation->loadAcquire()) {
+        return;
+    }
+    running = false;
+    idleTimer->start();
+}
+
+/**
+ * @brief Applies received token runs for one idle slice.
+ *
+ * The visible blocks are applied first, then the following lines of the
+ * document until the slice is used up. Once every block is colored the
+ * document is remembered as highlighted and the results are released.
+ */
+void HighlightEngine::applyPending() {
+    if (!document) {
+        return;
+    }
+    QElapsedTimer slice;
+    slice.start();
+    applying = true;
+
+    QTextBlock first = textEditor->cursorForPosition(QPoint(0, 0)).block();
+    int lastVisible = textEditor->cursorForPosition(QPoint(0, textEditor->viewport()->height() - 1)).blockNumber();
+    for (QTextBlock block = first; block.isValid() && block.blockNumber() <= lastVisible; block = block.next()) {
+        applyLine(block.blockNumber(), block);
+    }
+
+    QTextBlock block = document->findBlockByNumber(nextLine);
+    while (block.isValid() && slice.elapsed() < IdleSliceMs && applyLine(nextLine, block)) {
+        block = block.next();
+        ++nextLine;
+    }
+    applying = false;
+
+    if (!running && appliedCount == results.size()) {
+        states[document].highlighted = true;
+        cancel();
+    } else if (nextLine < status.size() && status[nextLine] != Pending) {
+        idleTimer->start();
+    }
+}
+
+/**
+ * @brief Moves the pass along with an edit of the document.
+ *
+ * The replaced lines drop their results and are marked as edited, the
+ * following ones move by the change in line count, and the edit is recorded
+ * so the batches still to come land on their current line.
+ *
+ * @param firstLine The first edited line.
+ * @param added The number of lines the edited lines now span.
+ */
+void HighlightEngine::shiftPass(int firstLine, int added) {
+    int removed = qBound(0, added - (document->blockCount() - results.size()), results.size() - firstLine);
+    for (int line = firstLine; line < firstLine + removed; ++line) {
+        if (status[line] == Applied) {
+            --appliedCount;
+        }
+    }
+    results.remove(firstLine, removed);
+    status.remove(firstLine, removed);
+    results.insert(firstLine, added, LineTokens());
+    status.insert(firstLine, added, Edited);
+    edits.append(Edit{firstLine, removed, added});
+    nextLine = qMin(nextLine, firstLine);
+}
+
+/**
+ * @brief Returns the current line of a line of the pass snapshot.
+ * @param passLine The line in the snapshot the pass tokenizes.
+ * @return The line in the document, -1 if the line was edited since.
+ */
+int HighlightEngine::currentLine(int passLine) const {
+    int line = passLine;
+    for (const Edit& edit : edits) {
+        if (line >= edit.firstLine + edit.removed) {
+            line += edit.added - edit.removed;
+        } else if (line >= edit.firstLine) {
+            return -1;
+        }
+    }
+    return line;
+}
+
+/**
+ * @brief Colors a line from the pass, unless it is already colored.
+ *
+ * The tokens of the pass are used when they were lexed from the state the
+ * previous line now ends with, or when that line is not colored yet. Edited
+ * lines, and lines whose previous state changed, are lexed again; the
+ * following lines already colored are then lexed again while their start
+ * state differs.
+ *
+ * @param line The line number (0-based).
+ * @param block The block of the line.
+ * @return True if the line is colored, false if it has to wait for the pass.
+ */
+bool HighlightEngine::applyLine(int line, QTextBlock block) {
+    if (status[line] == Applied) {
+        return true;
+    }
+    if (status[line] == Pending) {
+        return false;
+    }
+
+    bool previousKnown = line == 0 || status[line - 1] == Applied;
+    int startState = line == 0 ? -1 : block.previous().userState();
+    LineTokens& result = results[line];
+    if (status[line] == Received && (!previousKnown || result.startState == startState)) {
+        setFormats(block, result.tokens);
+    } else if (previousKnown) {
+        result.tokens.clear();
+        result.startState = startState;
+        result.state = lexer->tokenizeLine(block.text().left(MaxHighlightedLineLength), startState, result.tokens);
+        setFormats(block, result.tokens);
+    } else {
+        return false;
+    }
+    block.setUserState(result.state);
+    result.tokens = QVector<Lexer::Token>();
+    status[line] = Applied;
+    ++appliedCount;
+
+    int state = result.state;
+    QVector<Lexer::Token> tokens;
+    for (int next = line + 1; next < status.size() && status[next] == Applied; ++next) {
+        if (results[next].startState == state) {
+            break;
+        }
+        block = block.next();
+        tokens.clear();
+        results[next].startState = state;
+        state = lexer->tokenizeLine(block.text().left(MaxHighlightedLineLength), state, tokens);
+        results[next].state = state;
+        block.setUserState(state);
+        setFormats(block, tokens);
+    }
+    return true;
+}
+
+/**
+ * @brief Replaces the formats of a block with the formats of its tokens.
+ * @param block The block to format.
+ * @param tokens The tokens of the block text.
+ */
+void HighlightEngine::setFormats(QTextBlock block, const QVector<Lexer::Token>& tokens) {
+    QTextLayout* layout = block.layout();
+    if (tokens.isEmpty() && layout->formats().isEmpty()) {
+        return;
+    }
+
+    QVector<QTextLayout::FormatRange> ranges;
+    ranges.reserve(tokens.size());
+    for (const Lexer::Token& token : tokens) {
+        QTextLayout::FormatRange range;
+        range.start = token.start;
+        range.length = token.length;
+        range.format = formats[token.kind];
+        ranges.append(range);
+    }
+    layout->setFormats(ranges);
+    document->markContentsDirty(block.position(), block.length());
+}
+
+/**
+ * @brief Highlights a range of blocks, then the following ones while their lexer state changes.
+ * @param block The first block to highlight.
+ * @param last The last block that was edited.
+ */
+void HighlightEngine::rehighlight(QTextBlock block, const QTextBlock& last) {
+    applying = true;
+    QVector<Lexer::Token> tokens;
+    bool stateChanged = false;
+    while (block.isValid() && (block.position() <= last.position() || stateChanged)) {
+        QTextBlock previous = block.previous();
+        tokens.clear();
+        int state = lexer->tokenizeLine(block.text().left(MaxHighlightedLineLength),
+                                        previous.isValid() ? previous.userState() : -1, tokens);
+        stateChanged = state != block.userState();
+        block.setUserState(state);
+        setFormats(block, tokens);
+        block = block.next();
+    }
+    applying = false;
+}
+
+/**
+ * @brief Highlights the blocks touched by an edit.
+ *
+ * While a pass is running the edited blocks are handed to it instead, so the
+ * pass keeps going and only those blocks are lexed again.
+ *
+ * @param position The position of the edit.
+ * @param charsRemoved The number of characters removed.
+ * @param charsAdded The number of characters added.
+ */
+void HighlightEngine::contentsChange(int position, int charsRemoved, int charsAdded) {
+    Q_UNUSED(charsRemoved);
+    // Our own format changes are reported as edits too
+    if (applying || !document || !lexer) {
+        return;
+    }
+    QTextBlock first = document->findBlock(position);
+    QTextBlock last = document->findBlock(position + charsAdded);
+    if (!last.isValid()) {
+        last = document->lastBlock();
+    }
+    if (isHighlighting()) {
+        shiftPass(first.blockNumber(), last.blockNumber() - first.blockNumber() + 1);
+        idleTimer->start();
+        return;
+    }
+    rehighlight(first, last);
+}
@@ -0,0 +1,66 @@
+#include "../includes/json_lexer.hpp"
+
+/**
+ * @class JsonLexer
+ * @brief Line-by-line JSON tokenizer, used for SARIF reports and other JSON files.
+ *
+ * Object keys are reported as types, other strings as strings, and the
+ * literals true, false and null as keywords. JSON strings cannot span lines,
+ * so every line starts in the same state.
+ */
+
+namespace {
+inline bool isNumberPart(QChar c) {
+    return c.isDigit() || c == QLatin1Char('.') || c == QLatin1Char('e') || c == QLatin1Char('E') ||
+           c == QLatin1Char('+') || c == QLatin1Char('-');
+}
+}
+
+/**
+ * @brief Tokenizes one line.
+ * @param text The text of the line, without its line break.
+ * @param state Ignored, JSON lines do not depend on each other.
+ * @param tokens Receives the tokens of the line.
+ * @return Always 0.
+ */
+int JsonLexer::tokenizeLine(const QString& text, int state, QVector<Token>& tokens) const {
+    Q_UNUSED(state);
+    const QChar* data = text.constData();
+    const int length = text.length();
+    int i = 0;
+
+    while (i < length) {
+        const QChar c = data[i];
+        const int start = i;
+        if (c == QLatin1Char('"')) {
+            for (++i; i < length && data[i] != QLatin1Char('"'); ++i) {
+                if (data[i] == QLatin1Char('\\')) {
+                    ++i;
+                }
+            }
+            i = qMin(i + 1, length);
+
+            // A string followed by a colon is a key
+            int next = i;
+            while (next < length && data[next].isSpace()) {
+                ++next;
+            }
+            bool key = next < length && data[next] == QLatin1Char(':');
+            tokens.append(Token{start, i - start, key ? Type : String});
+        } else if (c.isDigit() || c == QLatin1Char('-')) {
+            for (++i; i < length && isNumberPart(data[i]); ++i) {
+            }
+            tokens.append(Token{start, i - start, Number});
+        } else if (c.isLetter()) {
+            for (++i; i < length && data[i].isLetter(); ++i) {
+            }
+            QStringRef word = text.midRef(start, i - start);
+            if (word == QLatin1String("true") || word == QLatin1String("false") || word == QLatin1String("null")) {
+                tokens.append(Token{start, i - start, Keyword});
+            }
+        } else {
+            ++i;
+        }
+    }
+    return 0;
+}
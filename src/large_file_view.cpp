@@ -0,0 +1,627 @@
+#include "../includes/large_file_view.hpp"
+#include "../includes/line_index.hpp"
+#include <QPainter>
+#include <QScrollBar>
+#include <QFontDatabase>
+#include <QHelpEvent>
+#include <QToolTip>
+#include <QRunnable>
+#include <QMetaObject>
+#include <algorithm>
+#include <climits>
+#include <functional>
+
+/**
+ * @class LargeFileView
+ * @brief Read-only viewer for files too large for the text editor.
+ *
+ * The file is memory-mapped and indexed by line (see MappedText); painting
+ * decodes only the lines in the viewport, so memory use does not grow with
+ * the file. Scrolling is done in whole lines. Findings are shown as line
+ * backgrounds and gutter markers from the finding index, with their columns
+ * underlined. find() runs on a worker that decodes and searches about a
+ * megabyte of whole lines at a time, checking for cancellation in between.
+ *
+ * Lines longer than MaxRenderedBytes, as in minified or generated code, are
+ * laid out on a fixed grid of one byte per character cell: only the slice
+ * under the horizontal scroll position is decoded and drawn, and a column
+ * maps to a position in constant time, however far into the line it is.
+ * Finding and match columns are converted to byte offsets there, by walking
+ * the UTF-8 lead bytes of the line, so they land on the right cell on lines
+ * that are not ASCII.
+ */
+
+namespace {
+const int MaxRenderedBytes = 4096;
+const int SliceMargin = 64;
+const int MarkerWidth = 8;
+const int Padding = 5;
+
+QColor severityColor(AuditResult::Severity severity) {
+    switch (severity) {
+    case AuditResult::Error:
+        return QColor(255, 0, 0);
+    case AuditResult::Warning:
+        return QColor(255, 165, 0);
+    default:
+        return QColor(0, 100, 255);
+    }
+}
+
+QColor severityBackground(AuditResult::Severity severity) {
+    switch (severity) {
+    case AuditResult::Error:
+        return QColor(255, 235, 235);
+    case AuditResult::Warning:
+        return QColor(255, 248, 220);
+    default:
+        return QColor(245, 245, 255);
+    }
+}
+}
+
+namespace {
+// About this many bytes of whole lines are decoded and searched at once
+const qint64 FindChunkBytes = 1024 * 1024;
+
+class FindTask : public QRunnable {
+public:
+    FindTask(const MappedText& text, const TextMatcher& matcher, int startLine, int startColumn, bool backward,
+             const QSharedPointer<QAtomicInt>& generation, const std::function<void(int, int, int, int)>& finish)
+        : text(text), matcher(matcher), startLine(startLine), startColumn(startColumn), backward(backward),
+          generation(generation), id(generation->loadAcquire()), finish(finish) {}
+
+    void run() override {
+        int line = -1;
+        int column = 0;
+        int length = 0;
+        if (backward ? findBackward(line, column, length) : findForward(line, column, length)) {
+            finish(id, line, column, length);
+        } else if (!cancelled()) {
+            finish(id, -1, 0, 0);
+        }
+    }
+
+private:
+    bool cancelled() const {
+        return generation->loadAcquire() != id;
+    }
+
+    // Last line of the chunk starting at a line
+    int chunkEnd(int first) const {
+        qint64 end = qMin(text.lineStart(first) + FindChunkBytes, text.byteCount() - 1);
+        return qMax(first, text.lineAt(qMax<qint64>(0, end)));
+    }
+
+    // First line of the chunk ending at a line
+    int chunkStart(int last) const {
+        qint64 start = text.lineStart(last) + text.lineLength(last) - FindChunkBytes;
+        return qMin(last, text.lineAt(qMax<qint64>(0, start)));
+    }
+
+    QString decode(int first, int last) const {
+        qint64 start = text.lineStart(first);
+        qint64 end = text.lineStart(last) + text.lineLength(last);
+        return QString::fromUtf8(text.data() + start, int(end - start));
+    }
+
+    // Converts a position in a chunk to a line and column
+    static void locate(const QString& chunk, int first, int position, int& line, int& column) {
+        line = first;
+        int lineStart = 0;
+        for (int newline = chunk.indexOf('\n'); newline >= 0 && newline < position;
+             newline = chunk.indexOf('\n', lineStart)) {
+            ++line;
+            lineStart = newline + 1;
+        }
+        column = position - lineStart;
+    }
+
+    bool findForward(int& line, int& column, int& length) const {
+        const int lineCount = text.lineCount();
+        for (int pass = 0; pass < 2; ++pass) {
+            // From the current match to the end, then from the start back to it
+            int first = pass == 0 ? startLine : 0;
+            int stop = pass == 0 ? lineCount - 1 : startLine;
+            while (first <= stop) {
+                if (cancelled()) {
+                    return false;
+                }
+                int last = qMin(chunkEnd(first), stop);
+                QString chunk = decode(first, last);
+                int from = pass == 0 && first == startLine ? startColumn + 1 : 0;
+                int position = matcher.indexIn(chunk, from, length);
+                if (position >= 0) {
+                    locate(chunk, first, position, line, column);
+                    return true;
+                }
+                first = last + 1;
+            }
+        }
+        return false;
+    }
+
+    bool findBackward(int& line, int& column, int& length) const {
+        const int lineCount = text.lineCount();
+        for (int pass = 0; pass < 2; ++pass) {
+            // From the current match to the start, then from the end back to it
+            int last = pass == 0 ? startLine : lineCount - 1;
+            int stop = pass == 0 ? 0 : startLine;
+            while (last >= stop) {
+                if (cancelled()) {
+                    return false;
+                }
+                int first = qMax(chunkStart(last), stop);
+                QString chunk = decode(first, last);
+                int limit = chunk.size() + 1;
+                if (pass == 0 && last == startLine && startColumn >= 0) {
+                    limit = chunk.lastIndexOf('\n') + 1 + startColumn;
+                }
+
+                int found = -1;
+                int foundLength = 0;
+                int matchLength = 0;
+                for (int position = matcher.indexIn(chunk, 0, matchLength); position >= 0 && position < limit;
+                     position = matcher.indexIn(chunk, position + 1, matchLength)) {
+                    found = position;
+                    foundLength = matchLength;
+                }
+                if (found >= 0) {
+                    locate(chunk, first, found, line, column);
+                    length = foundLength;
+                    return true;
+                }
+                last = first - 1;
+            }
+        }
+        return false;
+    }
+
+    const MappedText& text;
+    TextMatcher matcher;
+    int startLine;
+    int startColumn;
+    bool backward;
+    QSharedPointer<QAtomicInt> generation;
+    int id;
+    std::function<void(int, int, int, int)> finish;
+};
+}
+
+LargeFileView::LargeFileView(QWidget* parent)
+    : QAbstractScrollArea(parent)
+    , findings(FindingStore::empty())
+    , index(nullptr)
+    , fileId(-1)
+    , cursorLine(0)
+    , matchLine(-1)
+    , matchColumn(0)
+    , matchLength(0)
+    , findGeneration(new QAtomicInt(0))
+{
+    setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
+    viewport()->setAttribute(Qt::WA_OpaquePaintEvent);
+    verticalScrollBar()->setSingleStep(1);
+    findPool.setMaxThreadCount(1);
+}
+
+/**
+ * @brief Cancels the running search and waits for its worker to stop.
+ */
+LargeFileView::~LargeFileView() {
+    cancelFind();
+    findPool.waitForDone();
+}
+
+/**
+ * @brief Maps a file and shows it from its first line.
+ * @param path The file to open.
+ * @return True on success; errorString() describes the failure otherwise.
+ */
+bool LargeFileView::open(const QString& path) {
+    close();
+    if (!text.open(path)) {
+        return false;
+    }
+    this->path = path;
+    updateScrollBars();
+    verticalScrollBar()->setValue(0);
+    horizontalScrollBar()->setValue(0);
+    viewport()->update();
+    return true;
+}
+
+/**
+ * @brief Unmaps the current file.
+ */
+void LargeFileView::close() {
+    // The search reads the mapping, which must outlive it
+    cancelFind();
+    findPool.waitForDone();
+    text.close();
+    path.clear();
+    clearFindings();
+    cursorLine = 0;
+    matchLine = -1;
+    updateScrollBars();
+}
+
+/**
+ * @brief Scrolls a line into the middle of the view and marks it as current.
+ * @param line The line number (1-based).
+ * @param column The column (1-based).
+ * @param kind The unit the column counts, as reported with findings.
+ */
+void LargeFileView::goToLine(int line, int column, AuditResult::ColumnKind kind) {
+    if (text.lineCount() == 0) {
+        return;
+    }
+    cursorLine = qBound(0, line - 1, text.lineCount() - 1);
+    int first = verticalScrollBar()->value();
+    if (cursorLine < first || cursorLine >= first + visibleLineCount()) {
+        verticalScrollBar()->setValue(cursorLine - visibleLineCount() / 2);
+    }
+    ensureColumnVisible(cursorLine, displayColumn(cursorLine, column, kind));
+    viewport()->update();
+}
+
+/**
+ * @brief Sets the findings shown in the view.
+ * @param findings The findings the index was built from.
+ * @param index The finding index, which must outlive its use by the view.
+ * @param fileId The index ID of the file shown, -1 if none.
+ */
+void LargeFileView::setFindings(const FindingSnapshot& findings, const FindingIndex* index, int fileId) {
+    this->findings = findings;
+    this->index = index;
+    this->fileId = fileId;
+    viewport()->update();
+}
+
+/**
+ * @brief Removes the finding decorations.
+ */
+void LargeFileView::clearFindings() {
+    setFindings(FindingStore::empty(), nullptr, -1);
+}
+
+/**
+ * @brief Starts looking for the next or previous match of a query, wrapping around.
+ *
+ * The search runs on a worker and emits findFinished() once the match is
+ * selected, or when there is none. Starting another search or closing the
+ * file cancels it.
+ *
+ * @param query The pattern and search options.
+ * @param backward True to search towards the start of the file.
+ */
+void LargeFileView::find(const SearchEngine::Query& query, bool backward) {
+    cancelFind();
+    TextMatcher matcher(query);
+    if (query.pattern.isEmpty() || text.lineCount() == 0 || !matcher.isValid()) {
+        emit findFinished(false);
+        return;
+    }
+
+    const int startLine = matchLine >= 0 ? matchLine : cursorLine;
+    const int startColumn = matchLine >= 0 ? matchColumn : -1;
+    auto done = [this](int id, int line, int column, int length) {
+        QMetaObject::invokeMethod(this, [this, id, line, column, length]() { finishFind(id, line, column, length); },
+                                  Qt::QueuedConnection);
+    };
+    findPool.start(new FindTask(text, matcher, startLine, startColumn, backward, findGeneration, done));
+}
+
+/**
+ * @brief Stops the running search. Nothing is emitted for it afterwards.
+ */
+void LargeFileView::cancelFind() {
+    findGeneration->fetchAndAddOrdered(1);
+}
+
+/**
+ * @brief Selects the match found by a search.
+ * @param id The generation of the search.
+ * @param line The line of the match (0-based), -1 if there is none.
+ * @param column The column of the match in the line (0-based).
+ * @param length The length of the match.
+ */
+void LargeFileView::finishFind(int id, int line, int column, int length) {
+    if (id != findGeneration->loadAcquire()) {
+        return;
+    }
+    if (line >= 0) {
+        matchLine = line;
+        matchColumn = column;
+        matchLength = length;
+        goToLine(line + 1, column + 1);
+    }
+    emit findFinished(line >= 0);
+}
+
+/**
+ * @brief Returns the number of lines that fit in the viewport.
+ * @return The line count, at least 1.
+ */
+int LargeFileView::visibleLineCount() const {
+    return qMax(1, viewport()->height() / fontMetrics().lineSpacing());
+}
+
+/**
+ * @brief Returns the width of the line number and marker gutter.
+ * @return The width in pixels.
+ */
+int LargeFileView::gutterWidth() const {
+    int digits = QString::number(qMax(1, text.lineCount())).length();
+    return MarkerWidth + digits * fontMetrics().horizontalAdvance(QLatin1Char('9')) + Padding * 2;
+}
+
+/**
+ * @brief Decodes a line for display, with tabs expanded.
+ * @param line The line index (0-based), not a long line.
+ * @return The text to draw.
+ */
+QString LargeFileView::displayText(int line) const {
+    return text.lineText(line).replace('\t', "    ");
+}
+
+/**
+ * @brief Checks whether a line is drawn on the fixed grid of long lines.
+ * @param line The line index (0-based).
+ * @return True if the line is longer than MaxRenderedBytes.
+ */
+bool LargeFileView::isLongLine(int line) const {
+    return text.lineLength(line) > MaxRenderedBytes;
+}
+
+/**
+ * @brief Returns the width of a character cell.
+ * @return The width in pixels.
+ */
+int LargeFileView::charWidth() const {
+    return fontMetrics().horizontalAdvance(QLatin1Char('M'));
+}
+
+/**
+ * @brief Returns the horizontal position of a column in the displayed line.
+ * @param line The line index (0-based).
+ * @param column The column in the undecorated line text (0-based); a byte offset in long lines.
+ * @return The offset in pixels from the start of the text.
+ */
+int LargeFileView::columnX(int line, int column) const {
+    if (isLongLine(line)) {
+        return int(qMin<qint64>(qint64(column) * charWidth(), INT_MAX));
+    }
+    QString prefix = text.lineText(line).left(column);
+    return fontMetrics().horizontalAdvance(prefix.replace('\t', "    "));
+}
+
+/**
+ * @brief Converts a column to the column columnX() expects.
+ * @param line The line index (0-based).
+ * @param column The column (1-based), in the given unit.
+ * @param kind The unit the column counts.
+ * @return The 0-based column in UTF-16 code units, or the byte offset in long lines.
+ */
+int LargeFileView::displayColumn(int line, int column, AuditResult::ColumnKind kind) const {
+    if (isLongLine(line)) {
+        return int(qMin<qint64>(text.columnOffset(line, column, kind), INT_MAX));
+    }
+    QString lineText = text.lineText(line);
+    return LineIndex::columnOffset(lineText.constData(), lineText.size(), column, kind);
+}
+
+/**
+ * @brief Scrolls horizontally so that a column is visible.
+ * @param line The line index (0-based).
+ * @param column The column (0-based).
+ */
+void LargeFileView::ensureColumnVisible(int line, int column) {
+    int x = columnX(line, column);
+    int visibleWidth = viewport()->width() - gutterWidth();
+    if (x < horizontalScrollBar()->value() || x > horizontalScrollBar()->value() + visibleWidth - charWidth()) {
+        horizontalScrollBar()->setValue(x - visibleWidth / 3);
+    }
+}
+
+/**
+ * @brief Returns the line under a viewport position.
+ * @param y The vertical position in the viewport.
+ * @return The line index (0-based), or -1 past the end of the file.
+ */
+int LargeFileView::lineAtY(int y) const {
+    int line = verticalScrollBar()->value() + y / fontMetrics().lineSpacing();
+    return line < text.lineCount() ? line : -1;
+}
+
+/**
+ * @brief Updates the scroll ranges after the file or the viewport size changed.
+ */
+void LargeFileView::updateScrollBars() {
+    verticalScrollBar()->setRange(0, qMax(0, text.lineCount() - visibleLineCount()));
+    verticalScrollBar()->setPageStep(visibleLineCount());
+
+    int contentWidth = int(qMin<qint64>(qint64(text.longestLine()) * charWidth(), INT_MAX));
+    int visibleWidth = viewport()->width() - gutterWidth();
+    horizontalScrollBar()->setRange(0, qMax(0, contentWidth - visibleWidth));
+    horizontalScrollBar()->setPageStep(visibleWidth);
+    horizontalScrollBar()->setSingleStep(charWidth() * 4);
+}
+
+void LargeFileView::resizeEvent(QResizeEvent* event) {
+    QAbstractScrollArea::resizeEvent(event);
+    updateScrollBars();
+}
+
+void LargeFileView::mousePressEvent(QMouseEvent* event) {
+    int line = lineAtY(event->pos().y());
+    if (line >= 0) {
+        cursorLine = line;
+        viewport()->update();
+    }
+    QAbstractScrollArea::mousePressEvent(event);
+}
+
+/**
+ * @brief Shows the findings of the hovered line as a tooltip.
+ * @param event The event received by the viewport.
+ * @return True if the event was handled.
+ */
+bool LargeFileView::viewportEvent(QEvent* event) {
+    if (event->type() == QEvent::ToolTip && index && fileId >= 0) {
+        QHelpEvent* helpEvent = static_cast<QHelpEvent*>(event);
+        int line = lineAtY(helpEvent->pos().y());
+        QStringList lines;
+        if (line >= 0) {
+            for (int row : index->findingsAtLine(fileId, line + 1)) {
+                lines << QString("🔍 %1 (%2)\n📝 %3")
+                             .arg(findings->ruleId(row))
+                             .arg(findings->toolName(row))
+                             .arg(findings->issues(row).value(0));
+            }
+        }
+        if (lines.isEmpty()) {
+            QToolTip::hideText();
+        } else {
+            QToolTip::showText(helpEvent->globalPos(), lines.join("\n\n"), viewport());
+        }
+        return true;
+    }
+    return QAbstractScrollArea::viewportEvent(event);
+}
+
+void LargeFileView::paintEvent(QPaintEvent* event) {
+    QPainter painter(viewport());
+    QPalette pal = palette();
+    painter.fillRect(event->rect(), pal.base());
+
+    const int lineHeight = fontMetrics().lineSpacing();
+    const int ascent = fontMetrics().ascent();
+    const int gutter = gutterWidth();
+    const int scrollX = horizontalScrollBar()->value();
+    const int first = verticalScrollBar()->value() + event->rect().top() / lineHeight;
+    const int last = qMin(text.lineCount() - 1, verticalScrollBar()->value() + event->rect().bottom() / lineHeight);
+    if (first > last) {
+        return;
+    }
+
+    // Highest finding severity of every painted line, from one index query
+    QVector<int> lineSeverity(last - first + 1, -1);
+    QVector<int> rows;
+    if (index && fileId >= 0) {
+        rows = index->findingsInRange(fileId, first + 1, last + 1);
+        for (int row : rows) {
+            if (findings->ruleId(row).isEmpty()) {
+                continue;
+            }
+            int from = qMax(findings->line(row) - 1, first);
+            int to = qMin(qMax(findings->endLine(row), findings->line(row)) - 1, last);
+            for (int line = from; line <= to; ++line) {
+                lineSeverity[line - first] = qMax(lineSeverity[line - first], int(findings->severity(row)));
+            }
+        }
+    }
+
+    for (int line = first; line <= last; ++line) {
+        int y = (line - verticalScrollBar()->value()) * lineHeight;
+        QRect lineRect(gutter, y, viewport()->width() - gutter, lineHeight);
+        int severity = lineSeverity[line - first];
+
+        if (severity >= 0) {
+            painter.fillRect(lineRect, severityBackground(AuditResult::Severity(severity)));
+        } else if (line == cursorLine) {
+            painter.fillRect(lineRect, pal.alternateBase());
+        }
+
+        // Gutter: marker and line number
+        painter.fillRect(QRect(0, y, gutter, lineHeight), pal.window());
+        if (severity >= 0) {
+            painter.setPen(Qt::NoPen);
+            painter.setBrush(severityColor(AuditResult::Severity(severity)));
+            painter.drawEllipse(QRect(1, y + (lineHeight - MarkerWidth) / 2, MarkerWidth - 2, MarkerWidth - 2));
+        }
+        painter.setPen(pal.text().color());
+        painter.drawText(QRect(0, y, gutter - Padding, lineHeight), Qt::AlignRight | Qt::AlignVCenter,
+                         QString::number(line + 1));
+
+        // Text, clipped to the right of the gutter
+        painter.save();
+        painter.setClipRect(lineRect);
+        if (line == matchLine) {
+            int x = columnX(line, displayColumn(line, matchColumn + 1, AuditResult::Utf16CodeUnits));
+            int width = columnX(line, displayColumn(line, matchColumn + matchLength + 1, AuditResult::Utf16CodeUnits)) - x;
+            painter.fillRect(QRect(gutter - scrollX + x, y, width, lineHeight), QColor(255, 255, 0, 160));
+        }
+        painter.setPen(pal.text().color());
+        if (isLongLine(line)) {
+            // Only the slice under the viewport, one byte per cell
+            const int cell = charWidth();
+            qint64 offset = qMax<qint64>(0, scrollX / cell - SliceMargin);
+            int bytes = (viewport()->width() - gutter) / cell + 2 * SliceMargin;
+            drawSlice(painter, line, offset, bytes, gutter - scrollX, y + ascent);
+        } else {
+            painter.drawText(gutter - scrollX, y + ascent, displayText(line));
+        }
+
+        // Underline the columns of the findings starting on this line
+        for (int row : rows) {
+            if (findings->ruleId(row).isEmpty() || findings->line(row) - 1 != line || findings->column(row) <= 0) {
+                continue;
+            }
+            const AuditResult::ColumnKind kind = findings->columnKind(row);
+            int column = displayColumn(line, findings->column(row), kind);
+            int endColumn = column + 1;
+            if (findings->endLine(row) <= findings->line(row) && findings->endColumn(row) > findings->column(row)) {
+                endColumn = displayColumn(line, findings->endColumn(row), kind);
+            }
+            int x = columnX(line, column);
+            int width = qMax(columnX(line, endColumn) - x, charWidth());
+            painter.fillRect(QRect(gutter - scrollX + x, y + lineHeight - 2, width, 2),
+                             severityColor(findings->severity(row)));
+        }
+        painter.restore();
+    }
+}
+
+/**
+ * @brief Draws part of a long line on its grid of one byte per cell.
+ *
+ * Runs of ASCII are drawn at once. Every other character is drawn in the
+ * first cell of its bytes, so the text stays aligned with the byte offsets
+ * findings and matches are converted to.
+ *
+ * @param painter The painter of the viewport.
+ * @param line The line index (0-based), a long line.
+ * @param offset The byte offset of the slice in the line.
+ * @param maxBytes The maximum number of bytes to draw.
+ * @param x The horizontal position of the start of the line.
+ * @param baseline The baseline of the line.
+ */
+void LargeFileView::drawSlice(QPainter& painter, int line, qint64 offset, int maxBytes, int x, int baseline) const {
+    const char* start = text.data() + text.lineStart(line);
+    const qint64 length = text.lineLength(line);
+    const qint64 end = qMin(length, offset + maxBytes);
+    const int cell = charWidth();
+    while (offset < end && (uchar(start[offset]) & 0xC0) == 0x80) {
+        ++offset;
+    }
+
+    qint64 run = offset;
+    for (qint64 i = offset; ; ) {
+        if (i < end && uchar(start[i]) < 0x80) {
+            ++i;
+            continue;
+        }
+        if (i > run) {
+            QString ascii = QString::fromLatin1(start + run, int(i - run)).replace('\t', ' ');
+            painter.drawText(x + int(run * cell), baseline, ascii);
+        }
+        if (i >= end) {
+            break;
+        }
+        const int size = int(qMin<qint64>(MappedText::characterSize(start[i]), length - i));
+        painter.drawText(x + int(i * cell), baseline, QString::fromUtf8(start + i, size));
+        i += size;
+        run = i;
+    }
+}
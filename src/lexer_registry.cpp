@@ -0,0 +1,175 @@
+#include "../includes/lexer_registry.hpp"
+#include "../includes/cpp_lexer.hpp"
+#include "../includes/json_lexer.hpp"
+#include <QFile>
+#include <QFileInfo>
+#include <QMutexLocker>
+
+/**
+ * @class LexerRegistry
+ * @brief Chooses the lexer of a file from its extension or its first bytes.
+ *
+ * Lexers are registered with a factory and created on first use, so a
+ * language that is never opened costs nothing. A file whose extension is not
+ * registered is matched by sniffing its head. Files that are too big, or that
+ * look minified because of a very long line, get no lexer and are shown as
+ * plain text. The document loader chooses from the bytes it already read, on
+ * its worker thread; lexerForFile() reads the head itself. Lexers are
+ * stateless and shared by all documents.
+ */
+
+namespace {
+const qint64 MaxHighlightedSize = 8 * 1024 * 1024;
+const int MaxLineLength = 4096;
+const int SniffSize = 4096;
+
+/**
+ * @brief Measures the longest line of a sample of a file.
+ * @param head The first bytes of the file.
+ * @return The length of the longest line of the sample, in bytes.
+ */
+int longestLineOf(const QByteArray& head) {
+    int longest = 0;
+    int start = 0;
+    while (start < head.size()) {
+        int end = head.indexOf('\n', start);
+        if (end < 0) {
+            end = head.size();
+        }
+        longest = qMax(longest, end - start);
+        start = end + 1;
+    }
+    return longest;
+}
+
+bool looksLikeCpp(const QByteArray& head) {
+    for (const QByteArray& line : head.left(SniffSize).split('\n')) {
+        QByteArray trimmed = line.trimmed();
+        if (trimmed.startsWith("#include") || trimmed.startsWith("#pragma") ||
+            trimmed.startsWith("#ifndef") || trimmed.startsWith("#define")) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool looksLikeJson(const QByteArray& head) {
+    int i = head.startsWith("\xEF\xBB\xBF") ? 3 : 0;
+    while (i < head.size() && QChar::isSpace(uchar(head[i]))) {
+        ++i;
+    }
+    return i < head.size() && (head[i] == '{' || head[i] == '[');
+}
+}
+
+/**
+ * @brief Returns the registry shared by the application.
+ * @return The registry, with the built-in lexers registered.
+ */
+LexerRegistry& LexerRegistry::instance() {
+    static LexerRegistry registry;
+    return registry;
+}
+
+/**
+ * @brief Registers the built-in lexers.
+ */
+LexerRegistry::LexerRegistry() {
+    registerLexer("cpp", {"c", "cc", "cpp", "cxx", "c++", "h", "hh", "hpp", "hxx", "h++", "inl", "ipp", "tpp", "tcc"},
+                  []() { return new CppLexer(); }, looksLikeCpp);
+    registerLexer("json", {"json", "sarif"}, []() { return new JsonLexer(); }, looksLikeJson);
+}
+
+/**
+ * @brief Registers a lexer. The lexer is only created when first needed.
+ * @param name The language name.
+ * @param extensions The file extensions of the language, lower case and without the dot.
+ * @param factory Creates the lexer.
+ * @param sniffer Recognizes the language from the head of a file with an unknown extension.
+ */
+void LexerRegistry::registerLexer(const QString& name, const QStringList& extensions, const Factory& factory,
+                                  const Sniffer& sniffer) {
+    QMutexLocker locker(&mutex);
+    int index = entries.size();
+    entries.append(Entry{name, factory, sniffer, QSharedPointer<Lexer>()});
+    names.insert(name, index);
+    for (const QString& extension : extensions) {
+        this->extensions.insert(extension, index);
+    }
+}
+
+/**
+ * @brief Returns the lexer of a language.
+ * @param name The language name.
+ * @return The lexer, or nullptr if the language is not registered.
+ */
+const Lexer* LexerRegistry::lexer(const QString& name) {
+    QMutexLocker locker(&mutex);
+    int index = names.value(name, -1);
+    return index >= 0 ? load(index) : nullptr;
+}
+
+/**
+ * @brief Chooses the lexer of a file that has not been read yet.
+ *
+ * Reads the head of the file to sniff its language and to detect minified
+ * content, so it should not be called from the UI thread for files that
+ * are being loaded anyway.
+ *
+ * @param path The file path.
+ * @return The lexer, or nullptr if the file is to be shown as plain text.
+ */
+const Lexer* LexerRegistry::lexerForFile(const QString& path) {
+    QFile file(path);
+    if (file.size() > MaxHighlightedSize) {
+        return nullptr;
+    }
+    QByteArray head;
+    if (file.open(QIODevice::ReadOnly)) {
+        head = file.read(SampleSize);
+    }
+    return lexerForContent(path, file.size(), head, longestLineOf(head));
+}
+
+/**
+ * @brief Chooses the lexer of a file from content already read.
+ *
+ * Does no I/O and may be called from any thread.
+ *
+ * @param path The file path, for its extension.
+ * @param size The size of the file in bytes.
+ * @param head The first bytes of the file, up to SampleSize.
+ * @param longestLine The length of the longest line known, of the whole file or of the head.
+ * @return The lexer, or nullptr if the file is to be shown as plain text.
+ */
+const Lexer* LexerRegistry::lexerForContent(const QString& path, qint64 size, const QByteArray& head,
+                                            int longestLine) {
+    if (size > MaxHighlightedSize || longestLine > MaxLineLength) {
+        return nullptr;
+    }
+
+    QMutexLocker locker(&mutex);
+    int index = extensions.value(QFileInfo(path).suffix().toLower(), -1);
+    for (int i = 0; index < 0 && i < entries.size(); ++i) {
+        if (entries[i].sniffer && entries[i].sniffer(head)) {
+            index = i;
+        }
+    }
+    return index >= 0 ? load(index) : nullptr;
+}
+
+/**
+ * @brief Returns the lexer of an entry, creating it on first use.
+ *
+ * Must be called with the mutex locked.
+ *
+ * @param index The entry index.
+ * @return The lexer.
+ */
+const Lexer* LexerRegistry::load(int index) {
+    Entry& entry = entries[index];
+    if (!entry.lexer) {
+        entry.lexer.reset(entry.factory());
+    }
+    return entry.lexer.data();
+}
@@ -0,0 +1,147 @@
+#include "../includes/line_diff.hpp"
+#include <QHash>
+#include <algorithm>
+
+/**
+ * @class LineDiff
+ * @brief Myers diff over two sequences of line hashes.
+ */
+
+/**
+ * @brief Computes the shortest edit script between two sequences of lines.
+ *
+ * The common prefix and suffix are stripped first, so a small edit in a large
+ * file only diffs the few lines around it. The remaining range is diffed with
+ * Myers' greedy O((N+M)D) algorithm; only the [-d, d] diagonals of every step
+ * are kept for backtracking, so memory grows with D² rather than with the
+ * file size.
+ *
+ * @param oldLines The hashes of the original lines.
+ * @param newLines The hashes of the current lines.
+ * @param maxEdits The largest number of inserted plus deleted lines to search for.
+ * @param hunks Receives the changed ranges (0-based), in order.
+ * @return False if the files differ by more than maxEdits lines.
+ */
+bool LineDiff::compute(const QVector<uint>& oldLines, const QVector<uint>& newLines,
+                       int maxEdits, QVector<Hunk>& hunks) {
+    hunks.clear();
+    const int oldSize = oldLines.size();
+    const int newSize = newLines.size();
+
+    int prefix = 0;
+    while (prefix < oldSize && prefix < newSize && oldLines[prefix] == newLines[prefix]) {
+        ++prefix;
+    }
+    int suffix = 0;
+    while (suffix < oldSize - prefix && suffix < newSize - prefix &&
+           oldLines[oldSize - 1 - suffix] == newLines[newSize - 1 - suffix]) {
+        ++suffix;
+    }
+
+    const uint* a = oldLines.constData() + prefix;
+    const uint* b = newLines.constData() + prefix;
+    const int n = oldSize - prefix - suffix;
+    const int m = newSize - prefix - suffix;
+
+    if (n == 0 && m == 0) {
+        return true;
+    }
+    if (n == 0 || m == 0) {
+        hunks.append(Hunk{prefix, n, prefix, m});
+        return true;
+    }
+
+    const int maxD = qMin(n + m, maxEdits);
+    const int offset = maxD + 1;
+    QVector<int> v(2 * offset + 1, 0);
+    QVector<QVector<int>> trace;
+    int editCount = -1;
+
+    for (int d = 0; d <= maxD && editCount < 0; ++d) {
+        for (int k = -d; k <= d; k += 2) {
+            int x;
+            if (k == -d || (k != d && v[offset + k - 1] < v[offset + k + 1])) {
+                x = v[offset + k + 1];
+            } else {
+                x = v[offset + k - 1] + 1;
+            }
+            int y = x - k;
+            while (x < n && y < m && a[x] == b[y]) {
+                ++x;
+                ++y;
+            }
+            v[offset + k] = x;
+            if (x >= n && y >= m) {
+                editCount = d;
+                break;
+            }
+        }
+        trace.append(v.mid(offset - d, 2 * d + 1));
+    }
+
+    if (editCount < 0) {
+        return false;
+    }
+
+    // Walk back through the trace, collecting the diagonal runs of equal lines
+    struct Snake {
+        int x;
+        int y;
+        int length;
+    };
+    QVector<Snake> snakes;
+    int x = n;
+    int y = m;
+    for (int d = editCount; d > 0; --d) {
+        const QVector<int>& previous = trace[d - 1];
+        const int base = d - 1;
+        int k = x - y;
+        bool down = k == -d || (k != d && previous[k - 1 + base] < previous[k + 1 + base]);
+        int previousK = down ? k + 1 : k - 1;
+        int previousX = previous[previousK + base];
+        int previousY = previousX - previousK;
+        int snakeX = down ? previousX : previousX + 1;
+        int snakeY = down ? previousY + 1 : previousY;
+        if (x > snakeX) {
+            snakes.append(Snake{snakeX, snakeY, x - snakeX});
+        }
+        x = previousX;
+        y = previousY;
+    }
+    if (x > 0) {
+        snakes.append(Snake{0, 0, x});
+    }
+    std::reverse(snakes.begin(), snakes.end());
+    snakes.append(Snake{n, m, 0});
+
+    // Every gap between two runs of equal lines is a hunk
+    int oldPosition = 0;
+    int newPosition = 0;
+    for (const Snake& snake : snakes) {
+        if (snake.x > oldPosition || snake.y > newPosition) {
+            hunks.append(Hunk{prefix + oldPosition, snake.x - oldPosition,
+                              prefix + newPosition, snake.y - newPosition});
+        }
+        oldPosition = snake.x + snake.length;
+        newPosition = snake.y + snake.length;
+    }
+    return true;
+}
+
+/**
+ * @brief Hashes lines for diffing, ignoring whitespace differences.
+ *
+ * Lines are simplified first, so re-indenting code does not count as a
+ * change.
+ *
+ * @param lines The lines to hash.
+ * @return One hash per line.
+ */
+QVector<uint> LineDiff::hashLines(const QStringList& lines) {
+    QVector<uint> hashes;
+    hashes.reserve(lines.size());
+    for (const QString& line : lines) {
+        hashes.append(uint(qHash(line.simplified())));
+    }
+    return hashes;
+}
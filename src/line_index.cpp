@@ -0,0 +1,123 @@
+#include "../includes/line_index.hpp"
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define LINE_INDEX_SSE2
+#endif
+
+/**
+ * @class LineIndex
+ * @brief Converts finding columns to UTF-16 offsets and finds the lines of a text.
+ *
+ * Finding columns may count UTF-16 code units, as SARIF does by default,
+ * code points or UTF-8 bytes; columnOffset() converts them to an offset in
+ * the text of the line, walking only the start of the line. The editor does
+ * not need an index of its own: the block map of its document finds a line
+ * in logarithmic time and follows the edits. scanLines() records the line
+ * starts of a text in one pass, eight UTF-16 code units at a time where SSE2
+ * is available, along with whether each line is pure ASCII.
+ */
+
+/**
+ * @brief Converts a column to an offset in its line.
+ *
+ * A column that falls inside a character maps to the start of the character.
+ *
+ * @param line The text of the line.
+ * @param length The length of the line in UTF-16 code units.
+ * @param column The column (1-based), in the given unit.
+ * @param kind The unit the column counts.
+ * @return The offset in UTF-16 code units, at most length.
+ */
+int LineIndex::columnOffset(const QChar* line, int length, int column, AuditResult::ColumnKind kind) {
+    if (column <= 1) {
+        return 0;
+    }
+    const int target = column - 1;
+    if (kind == AuditResult::Utf16CodeUnits) {
+        return qMin(target, length);
+    }
+
+    int offset = 0;
+    int count = 0;
+    while (offset < length) {
+        bool pair = line[offset].isHighSurrogate() && offset + 1 < length && line[offset + 1].isLowSurrogate();
+        int size = 1;
+        if (kind == AuditResult::Utf8Bytes) {
+            ushort unit = line[offset].unicode();
+            size = pair ? 4 : (unit < 0x80 ? 1 : (unit < 0x800 ? 2 : 3));
+        }
+        if (count + size > target) {
+            break;
+        }
+        count += size;
+        offset += pair ? 2 : 1;
+    }
+    return offset;
+}
+
+/**
+ * @brief Records the start of every line of a text and whether each line is ASCII.
+ *
+ * Uses SSE2 to test 8 code units at a time where available; chunks without a
+ * newline, the vast majority, only update the flag of the current line.
+ *
+ * @param data The text.
+ * @param size The length of the text in UTF-16 code units.
+ * @param lineStarts Receives the line starts; the first line always starts at 0.
+ * @param asciiLines Receives one flag per line.
+ * @param vectorized False to scan one code unit at a time, as the tests compare.
+ */
+void LineIndex::scanLines(const QChar* data, int size, QVector<int>& lineStarts, QVector<bool>& asciiLines,
+                          bool vectorized) {
+    lineStarts.clear();
+    asciiLines.clear();
+    lineStarts.reserve(size / 32 + 1);
+    asciiLines.reserve(size / 32 + 1);
+    lineStarts.append(0);
+
+    const ushort* units = reinterpret_cast<const ushort*>(data);
+    bool ascii = true;
+    int i = 0;
+#ifdef LINE_INDEX_SSE2
+    const __m128i newline = _mm_set1_epi16('\n');
+    const __m128i highBits = _mm_set1_epi16(short(0xFF80));
+    const __m128i zero = _mm_setzero_si128();
+    for (; vectorized && i + 8 <= size; i += 8) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(units + i));
+        unsigned newlines = unsigned(_mm_movemask_epi8(_mm_cmpeq_epi16(chunk, newline)));
+        unsigned plain = unsigned(_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(chunk, highBits), zero)));
+        if (!newlines) {
+            ascii = ascii && plain == 0xFFFF;
+            continue;
+        }
+        // Two mask bits per code unit
+        for (int bit = 0; bit < 16; bit += 2) {
+            if (newlines & (1u << bit)) {
+                lineStarts.append(i + bit / 2 + 1);
+                asciiLines.append(ascii);
+                ascii = true;
+            } else if (!(plain & (1u << bit))) {
+                ascii = false;
+            }
+        }
+    }
+#else
+    Q_UNUSED(vectorized);
+#endif
+    for (; i < size; ++i) {
+        if (units[i] == '\n') {
+            lineStarts.append(i + 1);
+            asciiLines.append(ascii);
+            ascii = true;
+        } else if (units[i] >= 0x80) {
+            ascii = false;
+        }
+    }
+    asciiLines.append(ascii);
+
+    // A trailing newline does not start another line
+    if (lineStarts.size() > 1 && lineStarts.last() == size) {
+        lineStarts.removeLast();
+        asciiLines.removeLast();
+    }
+}
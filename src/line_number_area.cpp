@@ -1,10 +1,175 @@
 #include "../includes/line_number_area.hpp"
 #include <QPainter>
 #include <QTextBlock>
-#include <QScrollBar>
+#include <QPaintEvent>
+#include <QEvent>
+#include <QTextLayout>
 
-LineNumberArea::LineNumberArea(QTextEdit* editor) : QWidget(editor), textEditor(editor) {
-    setFixedWidth(40);  // Fixed width for line numbers
+/**
+ * @class LineNumberArea
+ * @brief Gutter showing line numbers and finding markers next to the editor.
+ *
+ * Lines are placed from the block geometry of the editor, so wrapped lines
+ * are handled, starting from the first visible block. Only the exposed
+ * region is painted: the editor's update requests are mirrored, so scrolling
+ * shifts the already painted pixels and repaints the uncovered strip, and
+ * an edit repaints the lines it touched. Digits are
+ * rendered once into pixmaps and blitted, and the severity markers of the
+ * painted lines come from a single finding index query.
+ */
+
+namespace {
+const int MarkerWidth = 8;
+const int Padding = 5;
+
+QColor severityColor(AuditResult::Severity severity) {
+    switch (severity) {
+    case AuditResult::Error:
+        return QColor(255, 0, 0);
+    case AuditResult::Warning:
+        return QColor(255, 165, 0);
+    default:
+        return QColor(0, 100, 255);
+    }
+}
+}
+
+LineNumberArea::LineNumberArea(SourceEditor* editor)
+    : QWidget(editor)
+    , textEditor(editor)
+    , findings(FindingStore::empty())
+    , index(nullptr)
+    , fileId(-1)
+    , digitCount(0)
+    , digitWidth(0)
+    , glyphRatio(0)
+{
+    setAttribute(Qt::WA_OpaquePaintEvent);
+    connect(textEditor, &SourceEditor::updateRequest, this, &LineNumberArea::updateArea);
+    textEditor->viewport()->installEventFilter(this);
+    attachDocument();
+}
+
+/**
+ * @brief Follows the document currently shown by the editor.
+ *
+ * Must be called again whenever the editor is given another document.
+ */
+void LineNumberArea::attachDocument() {
+    QTextDocument* document = textEditor->document();
+    connect(document, &QTextDocument::blockCountChanged, this, &LineNumberArea::updateWidth, Qt::UniqueConnection);
+    updateWidth();
+    update();
+}
+
+/**
+ * @brief Sets the findings whose severity is marked in the gutter.
+ * @param findings The findings the index was built from.
+ * @param index The finding index, which must outlive its use by the gutter.
+ * @param fileId The index ID of the file shown in the editor, -1 if none.
+ */
+void LineNumberArea::setFindings(const FindingSnapshot& findings, const FindingIndex* index, int fileId) {
+    this->findings = findings;
+    this->index = index;
+    this->fileId = fileId;
+    update();
+}
+
+/**
+ * @brief Removes the finding markers.
+ */
+void LineNumberArea::clearFindings() {
+    setFindings(FindingStore::empty(), nullptr, -1);
+}
+
+/**
+ * @brief Follows an update of the editor viewport.
+ * @param rect The region of the viewport to repaint.
+ * @param dy The distance the viewport was scrolled by, 0 if it was not.
+ */
+void LineNumberArea::updateArea(const QRect& rect, int dy) {
+    if (dy) {
+        scroll(0, dy); // Only the uncovered strip is repainted
+    } else {
+        QRect area(0, rect.top() + viewportOffset(), width(), rect.height());
+        update(area.intersected(this->rect()));
+    }
+}
+
+/**
+ * @brief Resizes the gutter when the number of digits of the last line changes.
+ */
+void LineNumberArea::updateWidth() {
+    int digits = QString::number(qMax(1, textEditor->document()->blockCount())).length();
+    if (digits == digitCount && digitWidth > 0) {
+        return;
+    }
+    digitCount = qMax(2, digits);
+    if (digitGlyphs.isEmpty()) {
+        buildGlyphs();
+    }
+    setFixedWidth(MarkerWidth + digitCount * digitWidth + Padding * 2);
+    update();
+}
+
+/**
+ * @brief Renders the ten digits with the current font, palette and pixel ratio.
+ */
+void LineNumberArea::buildGlyphs() {
+    QFontMetrics metrics(textEditor->font());
+    glyphRatio = devicePixelRatioF();
+    digitWidth = 0;
+    for (char digit = '0'; digit <= '9'; ++digit) {
+        digitWidth = qMax(digitWidth, metrics.horizontalAdvance(QLatin1Char(digit)));
+    }
+
+    digitGlyphs.clear();
+    for (char digit = '0'; digit <= '9'; ++digit) {
+        QPixmap glyph(QSize(digitWidth, metrics.height()) * glyphRatio);
+        glyph.setDevicePixelRatio(glyphRatio);
+        glyph.fill(Qt::transparent);
+        QPainter painter(&glyph);
+        painter.setFont(textEditor->font());
+        painter.setPen(palette().text().color());
+        painter.drawText(QRect(0, 0, digitWidth, metrics.height()), Qt::AlignCenter, QString(QLatin1Char(digit)));
+        digitGlyphs.append(glyph);
+    }
+}
+
+/**
+ * @brief Returns the vertical distance from the gutter's top to the editor viewport's top.
+ * @return The offset in pixels.
+ */
+int LineNumberArea::viewportOffset() const {
+    QWidget* viewport = textEditor->viewport();
+    return viewport->mapTo(window(), QPoint()).y() - mapTo(window(), QPoint()).y();
+}
+
+/**
+ * @brief Drops the cached glyphs when the font or palette changes.
+ * @param event The change event.
+ */
+void LineNumberArea::changeEvent(QEvent* event) {
+    if (event->type() == QEvent::FontChange || event->type() == QEvent::PaletteChange ||
+        event->type() == QEvent::StyleChange) {
+        digitGlyphs.clear();
+        digitWidth = 0;
+        updateWidth();
+    }
+    QWidget::changeEvent(event);
+}
+
+/**
+ * @brief Repaints the gutter when the editor viewport is resized, since wrapping may change.
+ * @param obj The object receiving the event.
+ * @param event The event to be processed.
+ * @return Always false, the event is not consumed.
+ */
+bool LineNumberArea::eventFilter(QObject* obj, QEvent* event) {
+    if (obj == textEditor->viewport() && event->type() == QEvent::Resize) {
+        update();
+    }
+    return QWidget::eventFilter(obj, event);
 }
 
 void LineNumberArea::paintEvent(QPaintEvent* event) {
@@ -13,22 +178,80 @@ void LineNumberArea::paintEvent(QPaintEvent* event) {
     // Use system palette colors
     QPalette pal = palette();
     painter.fillRect(event->rect(), pal.base());  // Background color
-    painter.setPen(pal.text().color());  // Text color
 
-    QTextDocument* doc = textEditor->document();
-    int blockCount = doc->blockCount();
-    int lineHeight = textEditor->fontMetrics().height();
-    int visibleLines = height() / lineHeight;
-    int firstVisibleLine = textEditor->verticalScrollBar()->value() / lineHeight;
+    if (digitGlyphs.isEmpty() || !qFuzzyCompare(glyphRatio, devicePixelRatioF())) {
+        buildGlyphs();
+    }
 
-    for (int i = 0; i < visibleLines && (firstVisibleLine + i) < blockCount; ++i) {
-        int lineNumber = firstVisibleLine + i + 1;
-        int y = i * lineHeight;
-        painter.drawText(0, y, width() - 5, lineHeight,
-                        Qt::AlignRight, QString::number(lineNumber));
+    const int offset = viewportOffset();
+    const int exposedTop = event->rect().top();
+    const int exposedBottom = event->rect().bottom();
+
+    // First block overlapping the exposed region
+    QTextBlock block = textEditor->firstVisibleBlock();
+    while (block.isValid() && textEditor->blockGeometry(block).bottom() + offset < exposedTop) {
+        block = block.next();
+    }
+    if (!block.isValid()) {
+        return;
+    }
+
+    // Collect the highest severity of every painted line with one index query
+    const int firstLine = block.blockNumber() + 1;
+    QVector<int> lineSeverity;
+    if (index && fileId >= 0) {
+        int lastLine = textEditor->cursorForPosition(QPoint(0, qMax(0, exposedBottom - viewportOffset()))).blockNumber() + 1;
+        lastLine = qMax(lastLine, firstLine);
+        lineSeverity.fill(-1, lastLine - firstLine + 1);
+        for (int row : index->findingsInRange(fileId, firstLine, lastLine)) {
+            if (findings->ruleId(row).isEmpty()) {
+                continue;
+            }
+            int first = qMax(findings->line(row), firstLine);
+            int last = qMin(qMax(findings->endLine(row), findings->line(row)), lastLine);
+            for (int line = first; line <= last; ++line) {
+                int& severity = lineSeverity[line - firstLine];
+                severity = qMax(severity, int(findings->severity(row)));
+            }
+        }
+    }
+
+    const int lineHeight = digitGlyphs.first().height() / digitGlyphs.first().devicePixelRatio();
+    for (; block.isValid(); block = block.next()) {
+        QRectF bounds = textEditor->blockGeometry(block);
+        int top = int(bounds.top()) + offset;
+        if (top > exposedBottom) {
+            break;
+        }
+        if (!block.isVisible() || top + int(bounds.height()) < exposedTop) {
+            continue;
+        }
+
+        // Align the number with the first line of the block
+        int y = top;
+        if (block.layout() && block.layout()->lineCount() > 0) {
+            QTextLine textLine = block.layout()->lineAt(0);
+            y += int(textLine.y() + (textLine.height() - lineHeight) / 2);
+        }
+
+        int line = block.blockNumber() + 1;
+        int relative = line - firstLine;
+        if (relative < lineSeverity.size() && lineSeverity[relative] >= 0) {
+            painter.setRenderHint(QPainter::Antialiasing);
+            painter.setPen(Qt::NoPen);
+            painter.setBrush(severityColor(AuditResult::Severity(lineSeverity[relative])));
+            painter.drawEllipse(QRectF(1, y + (lineHeight - MarkerWidth + 2) / 2.0, MarkerWidth - 2, MarkerWidth - 2));
+        }
+
+        // Blit the digits right-aligned
+        int x = width() - Padding - digitWidth;
+        for (int value = line; value > 0; value /= 10) {
+            painter.drawPixmap(x, y, digitGlyphs[value % 10]);
+            x -= digitWidth;
+        }
     }
 }
 
 QSize LineNumberArea::sizeHint() const {
-    return QSize(40, 0);  // Fixed width of 40 pixels
-} 
\ No newline at end of file
+    return QSize(MarkerWidth + digitCount * digitWidth + Padding * 2, 0);
+}
@@ -1,10 +1,23 @@
 #include "../includes/ide.hpp"
+#include "../includes/parser.hpp"
+#include "../includes/finding_store.hpp"
+#include "../includes/error_highlighter.hpp"
 #include <QApplication>
+#include <QCoreApplication>
+#include <QCommandLineParser>
 #include <QDebug>
 #include <QDir>
 #include <QMessageBox>
 #include <QFile>
 #include <iostream>
+#include <cstdio>
+#ifdef _WIN32
+#include <io.h>
+#define isatty _isatty
+#define fileno _fileno
+#else
+#include <unistd.h>
+#endif
 
 /**
  * @brief Checks for application updates.
@@ -61,6 +74,67 @@ void CheckRequirements() {
     CheckRequiredIcons();
 }
 
+/**
+ * @brief Writes the annotated source report of SARIF files, without starting the IDE.
+ *
+ * Usage: coretrace-qt --report <output|-> [--format html|ansi] [--source-root <dir>]
+ * [--context <lines>] [--jobs <threads>] <sarif files...>
+ *
+ * @param argc The number of command-line arguments.
+ * @param argv The array of command-line arguments.
+ * @return The exit code of the application.
+ */
+int WriteReport(int argc, char *argv[]) {
+    QCoreApplication app(argc, argv);
+    QCommandLineParser options;
+    options.setApplicationDescription("Writes an annotated source report of SARIF findings.");
+    options.addHelpOption();
+    options.addOption({"report", "Report file, - for the standard output.", "output"});
+    options.addOption({"format", "html or ansi; by default ansi only when writing to a terminal.", "format"});
+    options.addOption({"source-root", "Directory relative source paths are resolved against.", "dir"});
+    options.addOption({"context", "Lines shown around each finding, -1 for whole files.", "lines", "3"});
+    options.addOption({"jobs", "Files rendered in parallel, 0 for one per core.", "threads", "0"});
+    options.addPositionalArgument("sarif", "SARIF files to report.", "<sarif files...>");
+    options.process(app);
+
+    Parser parser;
+    QList<AuditResult> results;
+    for (const QString& path : options.positionalArguments()) {
+        QFile sarif(path);
+        if (!sarif.open(QIODevice::ReadOnly)) {
+            std::cerr << "Cannot read " << path.toStdString() << ": " << sarif.errorString().toStdString() << std::endl;
+            return 1;
+        }
+        bool foundResults = false;
+        results.append(parser.parseFindings(QString::fromUtf8(sarif.readAll()), foundResults));
+    }
+
+    const QString output = options.value("report");
+    QFile out;
+    bool opened = false;
+    if (output == "-") {
+        opened = out.open(stdout, QIODevice::WriteOnly);
+    } else {
+        out.setFileName(output);
+        opened = out.open(QIODevice::WriteOnly | QIODevice::Truncate);
+    }
+    if (!opened) {
+        std::cerr << "Cannot write " << output.toStdString() << ": " << out.errorString().toStdString() << std::endl;
+        return 1;
+    }
+
+    QString format = options.value("format");
+    if (format.isEmpty()) {
+        // Escape codes are only wanted on a terminal, not in a pipe or a file
+        format = output == "-" && isatty(fileno(stdout)) ? "ansi" : "html";
+    }
+    ErrorHighlighter report(format == "ansi" ? ErrorHighlighter::Ansi : ErrorHighlighter::Html);
+    report.setSourceRoot(options.value("source-root"));
+    report.setContextLines(options.value("context").toInt());
+    report.setThreadCount(options.value("jobs").toInt());
+    return report.writeReport(FindingStore::fromResults(results), &out) ? 0 : 1;
+}
+
 /**
  * @brief The main entry point of the application.
  * @param argc The number of command-line arguments.
@@ -68,6 +142,13 @@ void CheckRequirements() {
  * @return The exit code of the application.
  */
 int main(int argc, char *argv[]) {
+    // Reports are written headless, before any widget exists
+    for (int i = 1; i < argc; ++i) {
+        if (QString(argv[i]) == "--report" || QString(argv[i]).startsWith("--report=")) {
+            return WriteReport(argc, argv);
+        }
+    }
+
     QApplication app(argc, argv);
     CheckForUpdates();
     CheckRequirements();
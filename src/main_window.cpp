@@ -4,6 +4,7 @@
 #include "../includes/line_number_area.hpp"
 #include "../includes/syntax_highlighter.hpp"
 #include <iostream>
+#include <climits>
 #include <QVBoxLayout>
 #include <QWidget>
 #include <QToolBar>
@@ -38,6 +39,42 @@
 #include <QFrame>
 #include <QPushButton>
 #include <QEasingCurve>
+#include <QToolTip>
+#include <QTextBlock>
+#include <QRunnable>
+#include <functional>
+
+namespace {
+// Files from this size on are opened in the read-only large file view
+const qint64 LargeFileThreshold = 16 * 1024 * 1024;
+
+// Files with a line this long are edited without highlighting or line wrapping
+const int LongLineThreshold = 64 * 1024;
+
+// Marks the documents of such files, which are shown in long line mode
+const char* const LongLinesProperty = "longLines";
+
+// Estimated memory the documents of recently opened files may keep
+const qint64 DocumentCacheBudget = 64 * 1024 * 1024;
+
+// Characters of the finding's line quoted in its notification
+const int MaxNotificationCodeLength = 240;
+
+// Pause in typing after which code changed within a finding is analysed again, in ms
+const int ReauditDelay = 2000;
+
+class RemapTask : public QRunnable {
+public:
+    explicit RemapTask(const std::function<void()>& remap) : remap(remap) {}
+
+    void run() override {
+        remap();
+    }
+
+private:
+    std::function<void()> remap;
+};
+}
 
 /**
  * @brief Constructs the MainWindow object.
@@ -50,7 +87,7 @@ MainWindow::MainWindow(QWidget* parent)
     , centralWidget(nullptr)
     , mainLayout(nullptr)
     , fileTree(new FileTreeView(this))
-    , textEditor(new QTextEdit(this))
+    , textEditor(new SourceEditor(this))
     , fileSystemModel(new QFileSystemModel(this))
     , cliPanel(new CliOptionsPanel(this))
     , outputDisplay(new OutputDisplay(this))
@@ -59,15 +96,37 @@ MainWindow::MainWindow(QWidget* parent)
     , importAction(new QAction("Import", this))
     , autosaveAction(new QAction("Autosave", this))
     , autosaveEnabled(false)
-    , syntaxHighlighter(nullptr)
+    , analysedResults(FindingStore::empty())
+    , auditResults(FindingStore::empty())
     , securityNotificationFrame(nullptr)
     , securityNotificationIcon(nullptr)
     , securityNotificationText(nullptr)
     , notificationTimer(new QTimer(this))
     , notificationAnimation(nullptr)
     , notificationOpacity(nullptr)
-    , blinkTimer(new QTimer(this))
-    , blinkState(false)
+    , remapTimer(new QTimer(this))
+    , reauditTimer(new QTimer(this))
+    , remapGeneration(new QAtomicInt(0))
+    , reauditPending(false)
+    , decorator(new EditorDecorator(textEditor))
+    , emphasisOverlay(new EmphasisOverlay(textEditor))
+    , findBar(new FindBar(this))
+    , searchEngine(new SearchEngine(this))
+    , searchTimer(new QTimer(this))
+    , searchOrigin(0)
+    , jumpToMatch(false)
+    , projectSearch(new ProjectSearch(this))
+    , searchResultsPanel(new SearchResultsPanel(this))
+    , lineNumberArea(nullptr)
+    , editorStack(nullptr)
+    , largeFileView(new LargeFileView(this))
+    , documentLoader(new DocumentLoader(this))
+    , loadProgress(new QProgressBar(this))
+    , documentCache(new DocumentCache(DocumentCacheBudget, this))
+    , emptyDocument(new QTextDocument(this))
+    , fileTabs(nullptr)
+    , overviewRuler(nullptr)
+    , highlightEngine(nullptr)
 {
     setupUi();
     setupMenuBar();
@@ -87,6 +146,8 @@ MainWindow::MainWindow(QWidget* parent)
  */
 MainWindow::~MainWindow()
 {
+    remapGeneration->fetchAndAddOrdered(1);
+    remapPool.waitForDone();
     delete fileTree;
     delete textEditor;
     delete fileSystemModel;
@@ -141,6 +202,42 @@ void MainWindow::setupMenuBar()
     // Add Exit action
     QAction* exitAction = fileMenu->addAction("Exit");
     connect(exitAction, &QAction::triggered, this, &QMainWindow::close);
+    
+    QMenu* navigateMenu = menuBar->addMenu("Navigate");
+    
+    // Add finding navigation actions
+    QAction* nextFindingAction = navigateMenu->addAction("Next Finding");
+    nextFindingAction->setShortcut(QKeySequence(Qt::Key_F8));
+    nextFindingAction->setStatusTip("Jump to the next finding in the current file");
+    connect(nextFindingAction, &QAction::triggered, this, &MainWindow::nextFinding);
+    
+    QAction* previousFindingAction = navigateMenu->addAction("Previous Finding");
+    previousFindingAction->setShortcut(QKeySequence(Qt::SHIFT + Qt::Key_F8));
+    previousFindingAction->setStatusTip("Jump to the previous finding in the current file");
+    connect(previousFindingAction, &QAction::triggered, this, &MainWindow::previousFinding);
+    
+    navigateMenu->addSeparator();
+    
+    // Add search navigation actions
+    QAction* findAction = navigateMenu->addAction("Find...");
+    findAction->setShortcut(QKeySequence::Find);
+    findAction->setStatusTip("Search the current file");
+    connect(findAction, &QAction::triggered, this, &MainWindow::findNext);
+    
+    QAction* findNextAction = navigateMenu->addAction("Find Next");
+    findNextAction->setShortcut(QKeySequence::FindNext);
+    findNextAction->setStatusTip("Jump to the next search match");
+    connect(findNextAction, &QAction::triggered, this, &MainWindow::findNextMatch);
+    
+    QAction* findPreviousAction = navigateMenu->addAction("Find Previous");
+    findPreviousAction->setShortcut(QKeySequence::FindPrevious);
+    findPreviousAction->setStatusTip("Jump to the previous search match");
+    connect(findPreviousAction, &QAction::triggered, this, &MainWindow::findPreviousMatch);
+    
+    QAction* findInFilesAction = navigateMenu->addAction("Find in Files...");
+    findInFilesAction->setShortcut(QKeySequence(Qt::CTRL + Qt::SHIFT + Qt::Key_F));
+    findInFilesAction->setStatusTip("Search every file of the project");
+    connect(findInFilesAction, &QAction::triggered, this, &MainWindow::findInFiles);
 }
 
 /**
@@ -166,6 +263,13 @@ void MainWindow::setupToolBar()
 void MainWindow::setupStatusBar()
 {
     statusBar()->showMessage("Ready");
+    
+    // Progress of the file being loaded (hidden unless loading takes several chunks)
+    loadProgress->setMaximumWidth(150);
+    loadProgress->setRange(0, 100);
+    loadProgress->setTextVisible(false);
+    loadProgress->setVisible(false);
+    statusBar()->addPermanentWidget(loadProgress);
 }
 
 /**
@@ -208,31 +312,68 @@ void MainWindow::setupCentralWidget()
     outputDisplay->setVisible(false);  // Hide initially
     leftLayout->addWidget(outputDisplay);
     
+    // Add find-in-files results to left container (initially hidden)
+    searchResultsPanel->setMinimumWidth(150);
+    searchResultsPanel->setMaximumWidth(400);
+    searchResultsPanel->setSizePolicy(QSizePolicy::Fixed, QSizePolicy::Expanding);
+    searchResultsPanel->setVisible(false);
+    leftLayout->addWidget(searchResultsPanel);
+    
     // Add left container to splitter
     mainSplitter->addWidget(leftContainer);
     
-    // Create a container for the text editor and line numbers
+    // Create a container for the text editor, line numbers and find bar
     QWidget* editorContainer = new QWidget(this);
-    QHBoxLayout* editorLayout = new QHBoxLayout(editorContainer);
+    QVBoxLayout* editorContainerLayout = new QVBoxLayout(editorContainer);
+    editorContainerLayout->setContentsMargins(0, 0, 0, 0);
+    editorContainerLayout->setSpacing(0);
+    
+    // Add the tabs of the open files above the editor (hidden until a file is opened)
+    fileTabs = new QTabBar(editorContainer);
+    fileTabs->setTabsClosable(true);
+    fileTabs->setMovable(true);
+    fileTabs->setDocumentMode(true);
+    fileTabs->setExpanding(false);
+    fileTabs->setVisible(false);
+    editorContainerLayout->addWidget(fileTabs);
+    
+    // The editor and the large file view share the same place
+    editorStack = new QStackedWidget(editorContainer);
+    QWidget* editorPage = new QWidget(editorStack);
+    QHBoxLayout* editorLayout = new QHBoxLayout(editorPage);
     editorLayout->setContentsMargins(0, 0, 0, 0);
     editorLayout->setSpacing(0);
+    editorStack->addWidget(editorPage);
+    editorStack->addWidget(largeFileView);
+    editorContainerLayout->addWidget(editorStack);
+    
+    // Add the inline find bar below the editor (initially hidden)
+    findBar->setVisible(false);
+    editorContainerLayout->addWidget(findBar);
+    
+    // The editor starts on an untitled document, shown again when every tab is closed
+    SourceEditor::prepareDocument(emptyDocument);
+    textEditor->setDocument(emptyDocument);
+    highlightEngine = new HighlightEngine(textEditor);
+    highlightEngine->setLexer(emptyDocument, LexerRegistry::instance().lexer("cpp"));
     
     // Create and add line number area
-    LineNumberArea* lineNumberArea = new LineNumberArea(textEditor);
+    lineNumberArea = new LineNumberArea(textEditor);
     editorLayout->addWidget(lineNumberArea);
     
     // Add text editor to the container
     textEditor->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
     editorLayout->addWidget(textEditor);
-
-    // Create syntax highlighter
-    syntaxHighlighter = new CppHighlighter(textEditor->document());
+    
+    // Add the findings overview beside the editor scroll bar
+    overviewRuler = new OverviewRuler(textEditor);
+    editorLayout->addWidget(overviewRuler);
     
     // Initialize the security notification system
     createSecurityNotificationWidget();
     
     // Connect text editor resize event to update notification position
-    connect(textEditor, &QTextEdit::textChanged, [this]() {
+    connect(textEditor, &SourceEditor::textChanged, [this]() {
         if (securityNotificationFrame && securityNotificationFrame->isVisible()) {
             securityNotificationFrame->resize(textEditor->width() - 40, 
                                              securityNotificationFrame->height());
@@ -266,105 +407,436 @@ void MainWindow::setupCentralWidget()
     mainSplitter->setHandleWidth(5);
     mainSplitter->setChildrenCollapsible(false);
     
-    // Connect text editor signals to update line numbers
-    connect(textEditor->document(), &QTextDocument::blockCountChanged, this, [lineNumberArea]() {
-        lineNumberArea->update();
+    // Connect file selection signal
+    connect(fileTree, &FileTreeView::fileSelected, this, &MainWindow::openFile);
+    connect(fileTabs, &QTabBar::currentChanged, this, [this](int index) {
+        QString filePath = fileTabs->tabData(index).toString();
+        // Tabs are announced before their path is set
+        if (index >= 0 && !filePath.isEmpty() && filePath != currentFilePath) {
+            openFile(filePath);
+        }
     });
+    connect(fileTabs, &QTabBar::tabCloseRequested, this, &MainWindow::closeFileTab);
+
+    // Connect CLI panel execute signal
+    connect(cliPanel, &CliOptionsPanel::executeClicked, this, &MainWindow::runAudit);
     
-    connect(textEditor->verticalScrollBar(), &QScrollBar::valueChanged, this, [lineNumberArea]() {
-        lineNumberArea->update();
-    });
+    // Remove duplicate shortcut and ensure text editor captures Ctrl+S
+    textEditor->setFocus();
     
-    // Connect file selection signal
-    connect(fileTree, &FileTreeView::fileSelected, this, [this](const QString& filePath) {
-        // Save the current file if necessary before opening a new one
-        if (!currentFilePath.isEmpty() && textEditor->document()->isModified()) {
-            QMessageBox::StandardButton reply;
-            reply = QMessageBox::question(this, "Save Changes", 
-                "The current file has been modified. Do you want to save changes?",
-                QMessageBox::Yes|QMessageBox::No);
-                
-            if (reply == QMessageBox::Yes) {
-                saveCurrentFile();
-            }
+    // Install an event filter to capture keyboard shortcuts
+    textEditor->installEventFilter(this);
+    
+    // Finding tooltips are resolved on hover from the finding index
+    textEditor->viewport()->installEventFilter(this);
+    
+    // Move findings along with edits once typing pauses
+    remapTimer->setSingleShot(true);
+    remapTimer->setInterval(300);
+    connect(remapTimer, &QTimer::timeout, this, &MainWindow::remapFindings);
+    
+    // Analyse again once code within a finding changed and typing stopped for longer
+    reauditTimer->setSingleShot(true);
+    reauditTimer->setInterval(ReauditDelay);
+    connect(reauditTimer, &QTimer::timeout, this, &MainWindow::reaudit);
+    
+    // Search as the user types; a new query cancels the running search
+    searchTimer->setSingleShot(true);
+    searchTimer->setInterval(100);
+    connect(searchTimer, &QTimer::timeout, this, &MainWindow::startSearch);
+    connect(findBar, &FindBar::queryChanged, this, [this]() {
+        searchOrigin = textEditor->textCursor().selectionStart();
+        jumpToMatch = true;
+        searchTimer->start();
+    });
+    connect(findBar, &FindBar::findNext, this, &MainWindow::findNextMatch);
+    connect(findBar, &FindBar::findPrevious, this, &MainWindow::findPreviousMatch);
+    connect(findBar, &FindBar::closed, this, [this]() {
+        searchTimer->stop();
+        searchEngine->cancel();
+        decorator->setSearch(nullptr);
+        if (isLargeFile()) {
+            largeFileView->setFocus();
+        } else {
+            textEditor->setFocus();
         }
-        
-        // Open the new file
-        QFile file(filePath);
-        if (file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-            QTextStream in(&file);
-            textEditor->setPlainText(in.readAll());
-            file.close();
-            
-            // Update the current file path
-            currentFilePath = filePath;
-            statusBar()->showMessage("Editing: " + currentFilePath);
-            
-            // Reset the modification state
-            textEditor->document()->setModified(false);
+    });
+    connect(searchEngine, &SearchEngine::matchesChanged, this, [this]() {
+        decorator->refreshSearch();
+        updateSearchStatus();
+    });
+    // Find in files streams its results into the results panel
+    connect(searchResultsPanel, &SearchResultsPanel::searchRequested, this, &MainWindow::startProjectSearch);
+    connect(searchResultsPanel, &SearchResultsPanel::matchActivated, this, &MainWindow::openMatch);
+    connect(projectSearch, &ProjectSearch::matchesFound, this, [this](const QVector<FileMatch>& matches) {
+        searchResultsPanel->addMatches(matches);
+    });
+    connect(projectSearch, &ProjectSearch::finished, this,
+            [this](int filesSearched, int matchCount, const QString& error) {
+        QString status = QString("%1 matches in %2 files").arg(matchCount).arg(filesSearched);
+        if (!error.isEmpty()) {
+            status = error + " - " + status;
         }
+        searchResultsPanel->setStatus(status);
     });
-
-    // Connect CLI panel execute signal
-    connect(cliPanel, &CliOptionsPanel::executeClicked, this, [this](const QString& options) {
-        if (currentFilePath.isEmpty()) {
-            QMessageBox::warning(this, "No File Selected", 
-                "Please select a file to analyze first.");
-            return;
+    connect(searchEngine, &SearchEngine::finished, this, [this]() {
+        updateSearchStatus();
+        if (jumpToMatch) {
+            // Select the first match at or after where the query was typed
+            jumpToMatch = false;
+            selectMatch(searchEngine->nextMatch(searchOrigin - 1));
         }
-
-        // Save current file if modified
-        if (textEditor->document()->isModified()) {
-            saveCurrentFile();
+    });
+    
+    connect(largeFileView, &LargeFileView::findFinished, this, [this](bool found) {
+        if (found) {
+            findBar->setStatus(QString("Line %1").arg(largeFileView->currentLine()));
+        } else {
+            findBar->setStatus("No matches", true);
         }
+    });
+    
+    // Files are loaded in the background and handed over as finished documents
+    connect(documentLoader, &DocumentLoader::loaded, this, &MainWindow::documentLoaded);
+    connect(documentLoader, &DocumentLoader::progress, this, [this](qint64 bytesRead, qint64 totalBytes) {
+        loadProgress->setValue(int(bytesRead * 100 / qMax<qint64>(totalBytes, 1)));
+        loadProgress->setVisible(true);
+    });
+    connect(documentLoader, &DocumentLoader::failed, this, [this](const QString&, const QString& error) {
+        loadProgress->setVisible(false);
+        pendingPosition = QPoint();
+        if (fileTabIndex(currentFilePath) >= 0) {
+            fileTabs->setCurrentIndex(fileTabIndex(currentFilePath));
+        }
+        statusBar()->showMessage("Error opening file: " + error);
+    });
+    
+    // Enable document modification tracking
+    connect(emptyDocument, &QTextDocument::contentsChanged, this, &MainWindow::documentChanged);
+}
 
-        // Get IDE instance and perform audit with the selected options
-        IDE* ide = IDE::getInstance();
-        QList<AuditResult> results = ide->getAuditService()->performAudit(currentFilePath, options);
-        
-        // Debug logging
-        std::cout << "Executing with options: " << options.toStdString() << std::endl;
-        std::cout << "Number of results: " << results.size() << std::endl;
-        if (!results.isEmpty()) {
-            std::cout << "First result message: " << results[0].getMessage().toStdString() << std::endl;
+/**
+ * @brief Checks whether a file is opened in the read-only large file view.
+ * @param filePath The path of the file.
+ * @return True if the file is LargeFileThreshold bytes or more.
+ */
+bool MainWindow::opensReadOnly(const QString& filePath)
+{
+    return QFileInfo(filePath).size() >= LargeFileThreshold;
+}
+
+/**
+ * @brief Opens a file in the text editor.
+ * 
+ * Every opened file gets a tab. Files still in the document cache are shown
+ * again instantly, with their highlighting, undo history and view position;
+ * unsaved changes stay in their document until it is saved or its tab is
+ * closed. Files of LargeFileThreshold bytes or more are memory-mapped and
+ * shown read-only in the large file view instead, which only renders the
+ * visible lines and the visible slice of long lines.
+ * 
+ * Other files are loaded on a worker thread and shown once ready (see
+ * documentLoaded()); opening another file in the meantime cancels the load.
+ * 
+ * @param filePath The path of the file to open.
+ * @return True if the file was opened or its loading started.
+ */
+bool MainWindow::openFile(const QString& filePath)
+{
+    pendingPosition = QPoint();
+    if (QTextDocument* document = documentCache->document(filePath)) {
+        documentLoader->cancel();
+        showDocument(filePath, document);
+        return true;
+    }
+    
+    if (opensReadOnly(filePath)) {
+        documentLoader->cancel();
+        loadProgress->setVisible(false);
+        if (!largeFileView->open(filePath)) {
+            statusBar()->showMessage("Error opening file: " + largeFileView->errorString());
+            return false;
         }
-        
-        // Show the output display if it was hidden
-        if (!outputDisplay->isVisible()) {
-            outputDisplay->setVisible(true);
-            // Adjust splitter sizes to accommodate the output display
-            QList<int> sizes = mainSplitter->sizes();
-            sizes[0] = 300;  // Increase left panel width
-            mainSplitter->setSizes(sizes);
+        if (!isLargeFile()) {
+            storeViewState();
         }
+        // The view already shows the new file, which must stay mapped
+        clearEditorView(false);
+        editorStack->setCurrentWidget(largeFileView);
+        saveAction->setEnabled(false);
         
-        // Display results in status bar
-        QString resultMessage = QString("Analysis complete: %1 issues found").arg(results.size());
-        statusBar()->showMessage(resultMessage);
-        
-        // Show results in output display
-        QString outputText;
-        if (results.isEmpty()) {
-            outputText = "No issues found.";
-        } else {
-            outputText = results[0].getMessage();
-        }
-        outputDisplay->setOutput(outputText);
+        currentFilePath = filePath;
+        documentCache->setCurrent(filePath);
+        setWindowTitle("CoreTrace IDE");
+        selectFileTab(filePath);
+        largeFileView->setFindings(auditResults, &findingIndex, findingIndex.fileId(currentFilePath));
+        statusBar()->showMessage(QString("Viewing: %1 (%2 lines, read-only large file)")
+                                 .arg(currentFilePath).arg(largeFileView->lineCount()));
+        largeFileView->setFocus();
+        return true;
+    }
+    
+    // The editor keeps showing the current file until the new one is loaded
+    documentLoader->load(filePath);
+    statusBar()->showMessage("Loading: " + filePath + "...");
+    return true;
+}
+
+/**
+ * @brief Adds a document loaded in the background to the cache and shows it.
+ * 
+ * Minified or generated files with lines over LongLineThreshold characters
+ * stay editable, in the long line mode of the editor and without
+ * highlighting.
+ * 
+ * @param filePath The path of the loaded file.
+ * @param document The document holding the file content.
+ * @param longestLine The length of the longest line, measured by the loader.
+ * @param lexer The lexer the loader chose for the file, nullptr for plain text.
+ */
+void MainWindow::documentLoaded(const QString& filePath, QTextDocument* document, int longestLine,
+                                const Lexer* lexer)
+{
+    // Only source files pay for highlighting, huge or minified ones are plain text
+    const bool longLines = longestLine > LongLineThreshold;
+    document->setProperty(LongLinesProperty, longLines);
+    highlightEngine->setLexer(document, longLines ? nullptr : lexer);
+    document->setDefaultFont(textEditor->font());
+    connect(document, &QTextDocument::contentsChanged, this, &MainWindow::documentChanged);
+    connect(document, &QTextDocument::modificationChanged, this, [this, filePath]() {
+        updateFileTab(filePath);
     });
+    documentCache->insert(filePath, document);
+    showDocument(filePath, document);
+}
+
+/**
+ * @brief Shows a cached document in the editor.
+ * 
+ * The view state of the previous document is remembered and the one of the
+ * new document restored. The finding decorations of the file are rebuilt
+ * from the finding index.
+ * 
+ * @param filePath The path of the file.
+ * @param document The document of the file, owned by the document cache.
+ */
+void MainWindow::showDocument(const QString& filePath, QTextDocument* document)
+{
+    loadProgress->setVisible(false);
+    if (!isLargeFile()) {
+        storeViewState();
+    }
+    clearEditorView();
+    if (textEditor->document() != document) {
+        textEditor->setDocument(document);
+        lineNumberArea->attachDocument();
+        overviewRuler->attachDocument();
+        highlightEngine->attachDocument();
+    }
+    documentCache->setDisplayed(document);
+    const bool longLines = document->property(LongLinesProperty).toBool();
+    textEditor->setLongLineMode(longLines);
     
-    // Remove duplicate shortcut and ensure text editor captures Ctrl+S
-    textEditor->setFocus();
+    DocumentCache::ViewState view = documentCache->viewState(filePath);
+    QTextCursor cursor(document);
+    cursor.setPosition(qBound(0, view.cursorPosition, document->characterCount() - 1));
+    textEditor->setTextCursor(cursor);
+    textEditor->verticalScrollBar()->setValue(view.scrollValue);
+    
+    // Update the current file path
+    currentFilePath = filePath;
+    documentCache->setCurrent(filePath);
+    setWindowTitle(document->isModified() ? "CoreTrace IDE *" : "CoreTrace IDE");
+    statusBar()->showMessage(longLines ? "Editing: " + currentFilePath + " (very long lines, not highlighted)"
+                                       : "Editing: " + currentFilePath);
+    selectFileTab(filePath);
+    
+    // The ruler keeps one image per document, so this only applies what changed
+    int fileId = findingIndex.fileId(currentFilePath);
+    overviewRuler->setFindings(auditResults, &findingIndex, fileId);
+    if (findingIndex.findingCount(fileId) > 0) {
+        decorator->setFindings(auditResults, &findingIndex, fileId);
+        lineNumberArea->setFindings(auditResults, &findingIndex, fileId);
+    }
     
-    // Install an event filter to capture keyboard shortcuts
-    textEditor->installEventFilter(this);
+    if (findBar->isVisible() && !findBar->query().pattern.isEmpty()) {
+        searchTimer->start();
+    }
+    if (!pendingPosition.isNull()) {
+        goToPosition(pendingPosition.y(), pendingPosition.x());
+        pendingPosition = QPoint();
+    }
+}
+
+/**
+ * @brief Leaves the large file view and removes the decorations of the current document.
+ * @param closeLargeFile False to keep the file of the large file view mapped.
+ */
+void MainWindow::clearEditorView(bool closeLargeFile)
+{
+    if (isLargeFile()) {
+        if (closeLargeFile) {
+            largeFileView->close();
+        }
+        editorStack->setCurrentIndex(0);
+        saveAction->setEnabled(true);
+    }
+    decorator->clearAll();
+    lineNumberArea->clearFindings();
+    emphasisOverlay->stop();
+    hideSecurityNotification();
+}
+
+/**
+ * @brief Remembers the cursor and scroll position of the document in the editor.
+ */
+void MainWindow::storeViewState()
+{
+    DocumentCache::ViewState view;
+    view.cursorPosition = textEditor->textCursor().position();
+    view.scrollValue = textEditor->verticalScrollBar()->value();
+    documentCache->setViewState(currentFilePath, view);
+}
+
+/**
+ * @brief Selects the tab of a file, adding it if the file has none.
+ * @param filePath The path of the file.
+ */
+void MainWindow::selectFileTab(const QString& filePath)
+{
+    int index = fileTabIndex(filePath);
+    if (index < 0) {
+        index = fileTabs->addTab(QFileInfo(filePath).fileName());
+        fileTabs->setTabData(index, filePath);
+        fileTabs->setTabToolTip(index, filePath);
+    }
+    fileTabs->setCurrentIndex(index);
+    fileTabs->setVisible(true);
+}
+
+/**
+ * @brief Shows whether the document of a file has unsaved changes in its tab.
+ * @param filePath The path of the file.
+ */
+void MainWindow::updateFileTab(const QString& filePath)
+{
+    int index = fileTabIndex(filePath);
+    if (index < 0) {
+        return;
+    }
+    QTextDocument* document = documentCache->contains(filePath) ? documentCache->document(filePath) : nullptr;
+    QString title = QFileInfo(filePath).fileName();
+    fileTabs->setTabText(index, document && document->isModified() ? title + " *" : title);
+}
+
+/**
+ * @brief Returns the tab of a file.
+ * @param filePath The path of the file.
+ * @return The tab index, or -1 if the file has no tab.
+ */
+int MainWindow::fileTabIndex(const QString& filePath) const
+{
+    for (int i = 0; i < fileTabs->count(); ++i) {
+        if (fileTabs->tabData(i).toString() == filePath) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Closes the tab of a file and drops its document.
+ * 
+ * Offers to save the document first if it has unsaved changes. Closing the
+ * current tab shows the neighbouring one.
+ * 
+ * @param index The index of the tab.
+ */
+void MainWindow::closeFileTab(int index)
+{
+    QString filePath = fileTabs->tabData(index).toString();
+    QTextDocument* document = documentCache->contains(filePath) ? documentCache->document(filePath) : nullptr;
+    if (document && !maybeSave(filePath, document)) {
+        return;
+    }
     
-    // Enable document modification tracking
-    connect(textEditor->document(), &QTextDocument::contentsChanged, this, [this]() {
-        if (textEditor->document()->isModified() && !currentFilePath.isEmpty()) {
-            setWindowTitle("CoreTrace IDE *");
-            statusBar()->showMessage("Editing: " + currentFilePath + " (modified)");
+    // The editor still holds the document of the previous file while a large file is viewed
+    const bool current = filePath == currentFilePath;
+    if (current || (document && document == textEditor->document())) {
+        if (current) {
+            documentLoader->cancel();
+            clearEditorView();
         }
-    });
+        textEditor->setDocument(emptyDocument);
+        lineNumberArea->attachDocument();
+        overviewRuler->attachDocument();
+        highlightEngine->attachDocument();
+        documentCache->setDisplayed(emptyDocument);
+    }
+    if (current) {
+        currentFilePath.clear();
+        documentCache->setCurrent(QString());
+        setWindowTitle("CoreTrace IDE");
+        statusBar()->showMessage("Ready");
+    }
+    documentCache->remove(filePath);
+    
+    // Removing the current tab selects a neighbour, which opens it
+    fileTabs->removeTab(index);
+    fileTabs->setVisible(fileTabs->count() > 0);
+}
+
+/**
+ * @brief Offers to save a document with unsaved changes.
+ * @param filePath The path of the file.
+ * @param document The document of the file.
+ * @return True if the document may be dropped: it was saved, discarded or not modified.
+ */
+bool MainWindow::maybeSave(const QString& filePath, QTextDocument* document)
+{
+    if (!document->isModified()) {
+        return true;
+    }
+    QMessageBox::StandardButton reply = QMessageBox::question(this, "Save Changes",
+        QString("%1 has been modified. Do you want to save changes?").arg(QFileInfo(filePath).fileName()),
+        QMessageBox::Save | QMessageBox::Discard | QMessageBox::Cancel);
+    return reply == QMessageBox::Discard || (reply == QMessageBox::Save && saveDocument(filePath, document));
+}
+
+/**
+ * @brief Offers to save every document with unsaved changes before the window closes.
+ * 
+ * Cancelling, or failing to save, any of them keeps the window open.
+ * 
+ * @param event The close event.
+ */
+void MainWindow::closeEvent(QCloseEvent* event)
+{
+    for (const QString& filePath : documentCache->modifiedPaths()) {
+        if (!maybeSave(filePath, documentCache->document(filePath))) {
+            event->ignore();
+            return;
+        }
+        updateFileTab(filePath);
+    }
+    QMainWindow::closeEvent(event);
+}
+
+/**
+ * @brief Tracks modifications of the document shown in the editor.
+ */
+void MainWindow::documentChanged()
+{
+    if (textEditor->document()->isModified() && !currentFilePath.isEmpty()) {
+        setWindowTitle("CoreTrace IDE *");
+        statusBar()->showMessage("Editing: " + currentFilePath + " (modified)");
+    }
+    if (!analysedResults->isEmpty()) {
+        remapTimer->start();
+    }
+    if (findBar->isVisible() && !findBar->query().pattern.isEmpty()) {
+        searchTimer->start();
+    }
 }
 
 /**
@@ -396,6 +868,10 @@ bool MainWindow::eventFilter(QObject* obj, QEvent* event)
                 // No need to return true here as we want the event to continue propagating
             }
         }
+    } else if (obj == textEditor->viewport() && event->type() == QEvent::ToolTip) {
+        if (showFindingToolTip(static_cast<QHelpEvent*>(event))) {
+            return true;
+        }
     }
     
     // Let the parent class handle other events
@@ -434,12 +910,26 @@ void MainWindow::show() {
 
 /**
  * @brief Updates the audit results in the UI.
- * @param results The list of audit results to display.
+ * 
+ * The results are indexed per file so the findings of the open file are
+ * looked up directly instead of comparing every result's path. The snapshot
+ * is shared with the audit cache and the result views, not copied.
+ * 
+ * @param results The snapshot of audit results to display.
  */
-void MainWindow::updateAuditResults(const QList<AuditResult>& results) {
+void MainWindow::updateAuditResults(const FindingSnapshot& results) {
     // Clear previous security highlights
     clearSecurityHighlights();
     
+    // Findings the previous analysis did not report, matched by fingerprint
+    int newFindings = analysedResults->isEmpty() ? -1 : results->rowsNotIn(*analysedResults).size();
+    
+    // Remaps still running were computed for the previous findings
+    remapGeneration->fetchAndAddOrdered(1);
+    analysedResults = results;
+    auditResults = results;
+    findingIndex.build(*auditResults);
+    
     // Update the results view
     for (UIComponent* component : uiComponents) {
         if (AuditResultsView* resultsView = dynamic_cast<AuditResultsView*>(component)) {
@@ -447,24 +937,26 @@ void MainWindow::updateAuditResults(const QList<AuditResult>& results) {
         }
     }
     
-    // Highlight security issues in the text editor
-    bool foundSecurityIssues = false;
-    for (const AuditResult& result : results) {
-        if (result.hasLocationInfo() && !result.getRuleId().isEmpty()) {
-            // Check if this result is for the currently open file
-            QString currentFile = QFileInfo(currentFilePath).fileName();
-            QString resultFile = QFileInfo(result.getFilePath()).fileName();
-            
-            if (currentFile == resultFile || result.getFilePath().contains(currentFile)) {
-                highlightSecurityIssue(result);
-                foundSecurityIssues = true;
+    // Highlight security issues of the current file in the text editor
+    QVector<int> rows;
+    if (!currentFilePath.isEmpty()) {
+        int fileId = findingIndex.fileId(currentFilePath);
+        for (int row : findingIndex.findingsInRange(fileId, 1, INT_MAX)) {
+            if (!auditResults->ruleId(row).isEmpty()) {
+                rows.append(row);
             }
         }
     }
+    bool foundSecurityIssues = !rows.isEmpty();
+    highlightFindings(rows);
     
     // Show summary message
     if (foundSecurityIssues) {
-        statusBar()->showMessage(QString("Found security issues - highlighted in editor"), 8000);
+        QString message = "Found security issues - highlighted in editor";
+        if (newFindings >= 0) {
+            message += QString(" (%1 new since the last run)").arg(newFindings);
+        }
+        statusBar()->showMessage(message, 8000);
     }
 }
 
@@ -506,6 +998,7 @@ void MainWindow::addWidget(QWidget* widget, Qt::Alignment alignment) {
  */
 void MainWindow::setProjectRoot(const QString& path) {
     fileTree->setRootPath(path);
+    SnippetService::instance().setSourceRoot(path);
 }
 
 /**
@@ -517,20 +1010,43 @@ void MainWindow::saveCurrentFile()
         statusBar()->showMessage("No file to save");
         return;
     }
+    if (isLargeFile()) {
+        statusBar()->showMessage("Large files are opened read-only");
+        return;
+    }
     
-    QFile file(currentFilePath);
-    if (file.open(QIODevice::WriteOnly | QIODevice::Text)) {
-        QTextStream out(&file);
-        out << textEditor->toPlainText();
-        file.close();
-        
-        textEditor->document()->setModified(false);
+    if (saveDocument(currentFilePath, textEditor->document())) {
         setWindowTitle("CoreTrace IDE");
-        statusBar()->showMessage("File saved: " + currentFilePath);
-    } else {
+        if (reauditPending) {
+            reauditPending = false;
+            reauditTimer->start();
+        }
+    }
+}
+
+/**
+ * @brief Writes a document to its file.
+ * @param filePath The path of the file.
+ * @param document The document to save.
+ * @return True if the file was written.
+ */
+bool MainWindow::saveDocument(const QString& filePath, QTextDocument* document)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
         QMessageBox::critical(this, "Error", "Could not save file: " + file.errorString());
         statusBar()->showMessage("Error saving file: " + file.errorString());
+        return false;
     }
+    
+    QTextStream out(&file);
+    out << document->toPlainText();
+    file.close();
+    
+    document->setModified(false);
+    SnippetService::instance().invalidate(filePath);
+    statusBar()->showMessage("File saved: " + filePath);
+    return true;
 }
 
 /**
@@ -571,66 +1087,179 @@ void MainWindow::toggleAutosave()
 }
 
 /**
- * @brief Opens a search dialog and highlights all occurrences of the search term.
+ * @brief Opens the inline find bar and searches for its current query.
  */
 void MainWindow::findNext() {
-    // Create a custom dialog
-    QDialog* dialog = new QDialog(this);
-    dialog->setWindowTitle("Find Text");
-    dialog->setFixedSize(300, 50);
-    
-    // Create layout
-    QVBoxLayout* layout = new QVBoxLayout(dialog);
-    layout->setContentsMargins(10, 10, 10, 10);
-    
-    // Create line edit
-    QLineEdit* searchEdit = new QLineEdit(dialog);
-    searchEdit->setPlaceholderText("Enter text to find...");
-    layout->addWidget(searchEdit);
-    
-    // Set focus to line edit
-    searchEdit->setFocus();
-    
-    // Handle Enter key
-    connect(searchEdit, &QLineEdit::returnPressed, dialog, &QDialog::accept);
-    
-    // Handle Escape key
-    QShortcut* escapeShortcut = new QShortcut(QKeySequence(Qt::Key_Escape), dialog);
-    connect(escapeShortcut, &QShortcut::activated, dialog, &QDialog::reject);
-    
-    // Show dialog
-    if (dialog->exec() == QDialog::Accepted && !searchEdit->text().isEmpty()) {
-        QString searchTerm = searchEdit->text();
-        
-        // Clear previous highlights
-        QList<QTextEdit::ExtraSelection> extraSelections;
-        QTextEdit::ExtraSelection selection;
-        
-        // Create a more visible highlight color
-        QColor highlightColor(255, 255, 0, 100);  // Semi-transparent yellow
-        selection.format.setBackground(highlightColor);
-        selection.format.setForeground(Qt::black);  // Ensure text remains readable
-        
-        // Find all occurrences
-        QTextCursor cursor = textEditor->document()->find(searchTerm);
-        while (!cursor.isNull()) {
-            selection.cursor = cursor;
-            extraSelections.append(selection);
-            cursor = textEditor->document()->find(searchTerm, cursor);
+    findBar->activate();
+    if (!findBar->query().pattern.isEmpty()) {
+        startSearch();
+    }
+}
+
+/**
+ * @brief Selects the next search match after the cursor, wrapping around.
+ */
+void MainWindow::findNextMatch() {
+    if (isLargeFile()) {
+        findInLargeFile(false);
+        return;
+    }
+    selectMatch(searchEngine->nextMatch(textEditor->textCursor().selectionStart()));
+}
+
+/**
+ * @brief Selects the previous search match before the cursor, wrapping around.
+ */
+void MainWindow::findPreviousMatch() {
+    if (isLargeFile()) {
+        findInLargeFile(true);
+        return;
+    }
+    selectMatch(searchEngine->previousMatch(textEditor->textCursor().selectionStart()));
+}
+
+/**
+ * @brief Searches the current text for the query of the find bar.
+ * 
+ * The search runs in the background on a snapshot of the text and replaces
+ * any search still in progress. Matches are highlighted as they arrive.
+ */
+void MainWindow::startSearch() {
+    searchTimer->stop();
+    if (isLargeFile()) {
+        findInLargeFile(false);
+        return;
+    }
+    SearchEngine::Query query = findBar->query();
+    decorator->setSearch(query.pattern.isEmpty() ? nullptr : searchEngine);
+    searchEngine->search(textEditor->toPlainText(), query);
+    updateSearchStatus();
+}
+
+/**
+ * @brief Shows the find-in-files panel.
+ */
+void MainWindow::findInFiles() {
+    searchResultsPanel->activate();
+}
+
+/**
+ * @brief Searches the project for the query of the find-in-files panel.
+ */
+void MainWindow::startProjectSearch() {
+    QString rootPath = fileTree->rootPath();
+    if (rootPath.isEmpty()) {
+        rootPath = QDir::currentPath();
+    }
+    searchResultsPanel->startResults(rootPath);
+    projectSearch->search(rootPath, searchResultsPanel->query());
+}
+
+/**
+ * @brief Opens a find-in-files match in the editor.
+ * @param filePath The file containing the match.
+ * @param line The line of the match (1-based).
+ * @param column The column of the match (1-based).
+ */
+void MainWindow::openMatch(const QString& filePath, int line, int column) {
+    if (filePath != currentFilePath) {
+        if (!openFile(filePath)) {
+            return;
         }
-        
-        // Apply highlights
-        textEditor->setExtraSelections(extraSelections);
-        
-        // Move to first occurrence
-        if (!extraSelections.isEmpty()) {
-            textEditor->setTextCursor(extraSelections.first().cursor);
+        if (documentLoader->isLoading()) {
+            pendingPosition = QPoint(column, line); // Applied once loaded
+            return;
         }
-        
-        statusBar()->showMessage(QString("Found %1 occurrences").arg(extraSelections.size()), 3000);
+    }
+    goToPosition(line, column);
+}
+
+/**
+ * @brief Places the cursor of the current file at a position.
+ * @param line The line (1-based).
+ * @param column The column (1-based).
+ */
+void MainWindow::goToPosition(int line, int column) {
+    if (isLargeFile()) {
+        largeFileView->goToLine(line, column);
+        largeFileView->setFocus();
+        return;
     }
     
-    delete dialog;
+    QTextBlock block = textEditor->document()->findBlockByNumber(line - 1);
+    if (!block.isValid()) {
+        return;
+    }
+    QTextCursor cursor(block);
+    cursor.setPosition(block.position() + qBound(0, column - 1, block.length() - 1));
+    textEditor->setTextCursor(cursor);
+    textEditor->ensureCursorVisible();
+    textEditor->setFocus();
+}
+
+/**
+ * @brief Checks whether the current file is shown in the large file view.
+ * @return True if the current file is read-only and memory-mapped.
+ */
+bool MainWindow::isLargeFile() const {
+    return editorStack && editorStack->currentWidget() == largeFileView;
+}
+
+/**
+ * @brief Selects the next or previous match of the find bar query in the large file view.
+ * 
+ * The mapped file is searched in the background from the current match, so
+ * there is no match list to count; the status shows the line of the match
+ * once it is found instead.
+ * 
+ * @param backward True to search towards the start of the file.
+ */
+void MainWindow::findInLargeFile(bool backward) {
+    SearchEngine::Query query = findBar->query();
+    if (query.pattern.isEmpty()) {
+        largeFileView->cancelFind();
+        findBar->setStatus(QString());
+        return;
+    }
+    findBar->setStatus("Searching...");
+    largeFileView->find(query, backward);
+}
+
+/**
+ * @brief Selects a search match in the editor.
+ * @param index The index of the match, -1 if there is none.
+ */
+void MainWindow::selectMatch(int index) {
+    if (index < 0 || index >= searchEngine->matchCount()) {
+        return;
+    }
+    
+    const TextMatch& match = searchEngine->matches()[index];
+    int lastPosition = textEditor->document()->characterCount() - 1;
+    QTextCursor cursor = textEditor->textCursor();
+    cursor.setPosition(qMin(match.position, lastPosition));
+    cursor.setPosition(qMin(match.position + match.length, lastPosition), QTextCursor::KeepAnchor);
+    textEditor->setTextCursor(cursor);
+    textEditor->ensureCursorVisible();
+    
+    findBar->setStatus(QString("%1 of %2").arg(index + 1).arg(searchEngine->matchCount()));
+}
+
+/**
+ * @brief Shows the progress or the result of the search in the find bar.
+ */
+void MainWindow::updateSearchStatus() {
+    if (!searchEngine->errorString().isEmpty()) {
+        findBar->setStatus(searchEngine->errorString(), true);
+    } else if (findBar->query().pattern.isEmpty()) {
+        findBar->setStatus(QString());
+    } else if (searchEngine->isRunning()) {
+        findBar->setStatus(QString("%1 matches...").arg(searchEngine->matchCount()));
+    } else if (searchEngine->matchCount() == 0) {
+        findBar->setStatus("No matches", true);
+    } else {
+        findBar->setStatus(QString("%1 matches").arg(searchEngine->matchCount()));
+    }
 }
 
 /**
@@ -642,220 +1271,339 @@ void MainWindow::highlightSecurityIssue(const AuditResult& result) {
         return; // No location information available
     }
     
-    QTextDocument* document = textEditor->document();
-    QTextCursor cursor(document);
+    // Convert from 1-based to 0-based line number
+    QTextBlock block = textEditor->document()->findBlockByNumber(result.getLine() - 1);
+    if (!block.isValid()) {
+        return; // Line not found
+    }
     
-    // Move to the specified line (convert from 1-based to 0-based)
-    cursor.movePosition(QTextCursor::Start);
-    for (int i = 1; i < result.getLine(); ++i) {
-        if (!cursor.movePosition(QTextCursor::Down)) {
-            return; // Line not found
+    // Explicitly highlighted results stay decorated wherever the viewport is
+    QList<QTextEdit::ExtraSelection> newHighlights;
+    EditorDecorator::appendFindingSelections(block, result, newHighlights);
+    decorator->addSelections(EditorDecorator::PinnedLayer, newHighlights);
+    
+    focusFinding(EditorDecorator::codeCursor(block, result), result);
+}
+
+/**
+ * @brief Decorates the findings of the current file.
+ * 
+ * Decorations are materialized by the editor decorator for the lines around
+ * the viewport only. The most severe finding (the first one on ties) is
+ * focused, notified and animated.
+ * 
+ * @param rows The rows of the current audit results to highlight.
+ */
+void MainWindow::highlightFindings(const QVector<int>& rows) {
+    int focusRow = -1;
+    for (int row : rows) {
+        if (auditResults->hasLocationInfo(row) &&
+            (focusRow < 0 || auditResults->severity(row) > auditResults->severity(focusRow))) {
+            focusRow = row;
         }
     }
+    if (focusRow < 0) {
+        return;
+    }
+    
+    if (isLargeFile()) {
+        largeFileView->setFindings(auditResults, &findingIndex, findingIndex.fileId(currentFilePath));
+        goToFinding(focusRow);
+        return;
+    }
     
-    // Get the severity level for different visual treatments
-    QString ruleId = result.getRuleId();
-    bool isError = ruleId.contains("error", Qt::CaseInsensitive) || 
-                   result.getMessage().contains("error", Qt::CaseInsensitive);
-    bool isWarning = ruleId.contains("warning", Qt::CaseInsensitive) || 
-                     result.getMessage().contains("warning", Qt::CaseInsensitive) ||
-                     result.getMessage().contains("CWE", Qt::CaseInsensitive);
+    decorator->setFindings(auditResults, &findingIndex, findingIndex.fileId(currentFilePath));
+    lineNumberArea->setFindings(auditResults, &findingIndex, findingIndex.fileId(currentFilePath));
+    overviewRuler->setFindings(auditResults, &findingIndex, findingIndex.fileId(currentFilePath));
     
+    QTextBlock block = textEditor->document()->findBlockByNumber(auditResults->line(focusRow) - 1);
+    if (block.isValid()) {
+        AuditResult result = auditResults->toResult(focusRow);
+        focusFinding(EditorDecorator::codeCursor(block, result), result);
+    }
+}
+
+/**
+ * @brief Moves the cursor to a highlighted finding and draws attention to it.
+ * @param cursor The cursor selecting the problematic code.
+ * @param result The audit result of the finding.
+ */
+void MainWindow::focusFinding(const QTextCursor& cursor, const AuditResult& result) {
+    bool isError = result.getSeverity() == AuditResult::Error;
+    bool isWarning = result.getSeverity() == AuditResult::Warning;
     QString severity = isError ? "error" : (isWarning ? "warning" : "info");
     
-    // Create multiple highlighting effects for maximum visibility
-    QList<QTextEdit::ExtraSelection> newHighlights;
+    // Move cursor to the highlighted issue for visibility
+    textEditor->setTextCursor(cursor);
+    textEditor->ensureCursorVisible();
+    
+    // Show prominent security notification
+    showSecurityNotification(result);
     
-    // 1. Highlight the entire line with a subtle background
-    QTextCursor lineHighlightCursor = cursor;
-    lineHighlightCursor.movePosition(QTextCursor::StartOfLine);
-    lineHighlightCursor.movePosition(QTextCursor::EndOfLine, QTextCursor::KeepAnchor);
+    // Start animated blinking effect
+    animateHighlight(cursor, severity);
     
-    QTextEdit::ExtraSelection lineHighlight;
-    lineHighlight.cursor = lineHighlightCursor;
-    if (isError) {
-        lineHighlight.format.setBackground(QColor(255, 235, 235, 140)); // Slightly more visible for errors
-        lineHighlight.format.setProperty(QTextFormat::FullWidthSelection, true);
-    } else if (isWarning) {
-        lineHighlight.format.setBackground(QColor(255, 248, 220, 140)); // Slightly more visible for warnings
-        lineHighlight.format.setProperty(QTextFormat::FullWidthSelection, true);
+    // Enhanced status message with emojis
+    QString severityIcon = isError ? "🔴" : (isWarning ? "🟡" : "🔵");
+    statusBar()->showMessage(QString("%1 SECURITY ISSUE: %2 at line %3 - CHECK NOTIFICATION ABOVE!")
+                           .arg(severityIcon)
+                           .arg(result.getRuleId())
+                           .arg(result.getLine()), 15000);
+}
+
+/**
+ * @brief Moves the cursor to the next finding of the current file.
+ * 
+ * Wraps around to the first finding after the last one.
+ */
+void MainWindow::nextFinding() {
+    int fileId = findingIndex.fileId(currentFilePath);
+    int line = isLargeFile() ? largeFileView->currentLine() : textEditor->textCursor().blockNumber() + 1;
+    int row = findingIndex.nextFinding(fileId, line);
+    if (row < 0) {
+        row = findingIndex.nextFinding(fileId, 0);
+    }
+    goToFinding(row);
+}
+
+/**
+ * @brief Moves the cursor to the previous finding of the current file.
+ * 
+ * Wraps around to the last finding before the first one.
+ */
+void MainWindow::previousFinding() {
+    int fileId = findingIndex.fileId(currentFilePath);
+    int line = isLargeFile() ? largeFileView->currentLine() : textEditor->textCursor().blockNumber() + 1;
+    int row = findingIndex.previousFinding(fileId, line);
+    if (row < 0) {
+        row = findingIndex.previousFinding(fileId, INT_MAX);
+    }
+    goToFinding(row);
+}
+
+/**
+ * @brief Audits the current file with ctrace and shows the findings.
+ * 
+ * A modified file is saved first, since ctrace analyses the file on disk.
+ * The options are remembered for the re-audits scheduled by remapFindings().
+ * 
+ * @param options The options to be used with the ctrace CLI.
+ */
+void MainWindow::runAudit(const QString& options)
+{
+    if (currentFilePath.isEmpty()) {
+        QMessageBox::warning(this, "No File Selected", 
+            "Please select a file to analyze first.");
+        return;
+    }
+
+    // Save current file if modified
+    if (textEditor->document()->isModified()) {
+        saveCurrentFile();
+    }
+
+    // Get IDE instance and perform audit with the selected options
+    lastAuditOptions = options;
+    reauditPending = false;
+    reauditTimer->stop();
+    IDE* ide = IDE::getInstance();
+    FindingSnapshot results = ide->getAuditService()->performAudit(currentFilePath, options);
+    
+    // Debug logging
+    std::cout << "Executing with options: " << options.toStdString() << std::endl;
+    std::cout << "Number of results: " << results->size() << std::endl;
+    if (!results->isEmpty()) {
+        std::cout << "First result message: " << results->message(0).toStdString() << std::endl;
+    }
+    
+    // Show the output display if it was hidden
+    if (!outputDisplay->isVisible()) {
+        outputDisplay->setVisible(true);
+        // Adjust splitter sizes to accommodate the output display
+        QList<int> sizes = mainSplitter->sizes();
+        sizes[0] = 300;  // Increase left panel width
+        mainSplitter->setSizes(sizes);
+    }
+    
+    // Display results in status bar
+    QString resultMessage = QString("Analysis complete: %1 issues found").arg(results->size());
+    statusBar()->showMessage(resultMessage);
+    
+    // Show results in output display
+    QString outputText;
+    if (results->isEmpty()) {
+        outputText = "No issues found.";
     } else {
-        lineHighlight.format.setBackground(QColor(245, 245, 255, 140)); // Slightly more visible for info
-        lineHighlight.format.setProperty(QTextFormat::FullWidthSelection, true);
+        outputText = results->message(0);
     }
-    newHighlights.append(lineHighlight);
+    outputDisplay->setOutput(outputText);
     
-    // 2. Highlight the specific problematic code section
-    QTextCursor specificCursor = cursor;
+    // Index the findings and highlight those of the current file
+    updateAuditResults(results);
+}
+
+/**
+ * @brief Moves the findings of the current file along with the edits made since the audit.
+ * 
+ * Only the text of the document is taken on the UI thread; it is split and
+ * diffed against the analysed content on a worker, and the relocated
+ * findings are applied by remapFinished(). Edits made in the meantime start
+ * another remap, which supersedes this one.
+ */
+void MainWindow::remapFindings() {
+    if (currentFilePath.isEmpty() || isLargeFile()) {
+        return;
+    }
     
-    // Move to the specified column if available
-    if (result.getColumn() > 0) {
-        specificCursor.movePosition(QTextCursor::StartOfLine);
-        specificCursor.movePosition(QTextCursor::Right, QTextCursor::MoveAnchor, result.getColumn() - 1);
+    QStringList analysed = IDE::getInstance()->getAuditService()->analysedContent(currentFilePath);
+    if (analysed.isEmpty()) {
+        return;
     }
     
-    // Select the problematic text with enhanced logic
-    int selectionLength = 1;
-    if (result.getEndColumn() > result.getColumn()) {
-        selectionLength = result.getEndColumn() - result.getColumn();
-    } else {
-        // Enhanced text selection logic
-        QString lineText = specificCursor.block().text();
-        int startPos = specificCursor.positionInBlock();
-        
-        // Try to select meaningful code constructs
-        if (startPos < lineText.length()) {
-            QChar currentChar = lineText[startPos];
-            
-            // If we're at a function call, select the whole function
-            if (currentChar.isLetter() || currentChar == '_') {
-                // Select identifier
-                while (startPos + selectionLength < lineText.length() && 
-                       (lineText[startPos + selectionLength].isLetterOrNumber() || 
-                        lineText[startPos + selectionLength] == '_')) {
-                    selectionLength++;
-                }
-                
-                // If followed by '(', include the parentheses and arguments
-                if (startPos + selectionLength < lineText.length() && 
-                    lineText[startPos + selectionLength] == '(') {
-                    int parenCount = 0;
-                    while (startPos + selectionLength < lineText.length()) {
-                        QChar c = lineText[startPos + selectionLength];
-                        selectionLength++;
-                        if (c == '(') parenCount++;
-                        else if (c == ')') {
-                            parenCount--;
-                            if (parenCount == 0) break;
-                        }
-                    }
-                }
-            }
-            // If we're at a string literal, select the whole string
-            else if (currentChar == '"' || currentChar == '\'') {
-                QChar quote = currentChar;
-                selectionLength = 1;
-                while (startPos + selectionLength < lineText.length()) {
-                    QChar c = lineText[startPos + selectionLength];
-                    selectionLength++;
-                    if (c == quote && lineText[startPos + selectionLength - 2] != '\\') {
-                        break;
-                    }
-                }
-            }
-        }
-        
-        // Ensure minimum visibility
-        if (selectionLength < 3) {
-            selectionLength = qMin(10, lineText.length() - startPos);
+    const int id = remapGeneration->fetchAndAddOrdered(1) + 1;
+    QSharedPointer<QAtomicInt> generation = remapGeneration;
+    const QString filePath = currentFilePath;
+    const FindingSnapshot findings = analysedResults;
+    const QString content = textEditor->toPlainText();
+    remapPool.start(new RemapTask([this, id, generation, filePath, findings, analysed, content]() {
+        if (generation->loadAcquire() != id) {
+            return;
         }
+        bool needsReaudit = false;
+        FindingSnapshot remapped = AuditService::remapFindings(filePath, findings, analysed, content, needsReaudit);
+        QMetaObject::invokeMethod(this, [this, id, filePath, remapped, needsReaudit]() {
+            remapFinished(id, filePath, remapped, needsReaudit);
+        }, Qt::QueuedConnection);
+    }));
+}
+
+/**
+ * @brief Shows the findings relocated by the latest remap.
+ * 
+ * The finding index is rebuilt from the relocated findings so navigation and
+ * tooltips point at the right lines without waiting for a new analysis.
+ * When code within a finding changed, a new analysis is scheduled for when
+ * typing has paused.
+ * 
+ * @param id The generation of the remap.
+ * @param filePath The file the findings were remapped for.
+ * @param findings The relocated findings.
+ * @param needsReaudit True if code changed within the lines of a finding.
+ */
+void MainWindow::remapFinished(int id, const QString& filePath, const FindingSnapshot& findings, bool needsReaudit) {
+    if (id != remapGeneration->loadAcquire() || filePath != currentFilePath || isLargeFile()) {
+        return;
     }
     
-    specificCursor.movePosition(QTextCursor::Right, QTextCursor::KeepAnchor, selectionLength);
-    
-    // Create enhanced specific highlight with more prominent styling
-    QTextEdit::ExtraSelection specificHighlight;
-    specificHighlight.cursor = specificCursor;
+    auditResults = findings;
+    findingIndex.build(*auditResults);
+    if (decorator->hasFindings()) {
+        decorator->setFindings(auditResults, &findingIndex, findingIndex.fileId(currentFilePath));
+        lineNumberArea->setFindings(auditResults, &findingIndex, findingIndex.fileId(currentFilePath));
+        overviewRuler->setFindings(auditResults, &findingIndex, findingIndex.fileId(currentFilePath));
+    }
     
-    if (isError) {
-        // Error styling - bright red with strong emphasis and border
-        specificHighlight.format.setBackground(QColor(255, 80, 80, 220));
-        specificHighlight.format.setForeground(QColor(255, 255, 255));
-        specificHighlight.format.setFontWeight(QFont::Bold);
-        specificHighlight.format.setUnderlineColor(QColor(200, 0, 0));
-        specificHighlight.format.setUnderlineStyle(QTextCharFormat::WaveUnderline);
-        specificHighlight.format.setProperty(QTextFormat::OutlinePen, QPen(QColor(150, 0, 0), 3));
-    } else if (isWarning) {
-        // Warning styling - orange/yellow with medium emphasis and border
-        specificHighlight.format.setBackground(QColor(255, 140, 0, 200));
-        specificHighlight.format.setForeground(QColor(255, 255, 255));
-        specificHighlight.format.setFontWeight(QFont::Bold);
-        specificHighlight.format.setUnderlineColor(QColor(255, 140, 0));
-        specificHighlight.format.setUnderlineStyle(QTextCharFormat::WaveUnderline);
-        specificHighlight.format.setProperty(QTextFormat::OutlinePen, QPen(QColor(200, 100, 0), 2));
-    } else {
-        // Info styling - blue with subtle emphasis and border
-        specificHighlight.format.setBackground(QColor(100, 150, 255, 170));
-        specificHighlight.format.setForeground(QColor(255, 255, 255));
-        specificHighlight.format.setFontWeight(QFont::Bold);
-        specificHighlight.format.setUnderlineColor(QColor(0, 100, 200));
-        specificHighlight.format.setUnderlineStyle(QTextCharFormat::DotLine);
-        specificHighlight.format.setProperty(QTextFormat::OutlinePen, QPen(QColor(0, 100, 200), 1));
-    }
-    
-    // Enhanced tooltip with more information and emojis
-    QString tooltip = QString("🚨 SECURITY ISSUE DETECTED 🚨\n\n"
-                             "🔍 Rule: %1\n"
-                             "📝 Description: %2\n"
-                             "📍 Location: Line %3, Column %4\n\n"
-                             "💡 Click to see full details in results panel")
-                     .arg(result.getRuleId())
-                     .arg(result.getMessage().split('\n').first()) // First line of message
-                     .arg(result.getLine())
-                     .arg(result.getColumn());
-    specificHighlight.format.setToolTip(tooltip);
-    
-    newHighlights.append(specificHighlight);
-    
-    // 3. Add a prominent left margin indicator with icon-like effect
-    QTextCursor marginCursor = cursor;
-    marginCursor.movePosition(QTextCursor::StartOfLine);
-    marginCursor.movePosition(QTextCursor::Right, QTextCursor::KeepAnchor, 2);
-    
-    QTextEdit::ExtraSelection marginHighlight;
-    marginHighlight.cursor = marginCursor;
-    if (isError) {
-        marginHighlight.format.setBackground(QColor(255, 0, 0, 150));
-        marginHighlight.format.setProperty(QTextFormat::OutlinePen, QPen(QColor(200, 0, 0), 4));
-    } else if (isWarning) {
-        marginHighlight.format.setBackground(QColor(255, 165, 0, 150));
-        marginHighlight.format.setProperty(QTextFormat::OutlinePen, QPen(QColor(200, 100, 0), 3));
-    } else {
-        marginHighlight.format.setBackground(QColor(0, 100, 255, 150));
-        marginHighlight.format.setProperty(QTextFormat::OutlinePen, QPen(QColor(0, 100, 200), 2));
+    if (needsReaudit) {
+        reauditTimer->start();
+    }
+}
+
+/**
+ * @brief Analyses the current file again after code within a finding changed.
+ * 
+ * ctrace reads the file from disk, so unsaved changes are only saved here
+ * when autosave is enabled; otherwise the analysis waits for the next save.
+ */
+void MainWindow::reaudit() {
+    if (currentFilePath.isEmpty() || isLargeFile() || analysedResults->isEmpty()) {
+        return;
+    }
+    if (textEditor->document()->isModified() && !autosaveEnabled) {
+        reauditPending = true;
+        statusBar()->showMessage("Code changed since the last analysis - save to refresh the findings", 5000);
+        return;
+    }
+    runAudit(lastAuditOptions);
+}
+
+/**
+ * @brief Places the cursor on a finding and shows its notification.
+ * @param row The index of the finding in the current audit results.
+ */
+void MainWindow::goToFinding(int row) {
+    if (row < 0 || row >= auditResults->size()) {
+        statusBar()->showMessage("No findings in the current file", 3000);
+        return;
     }
-    newHighlights.append(marginHighlight);
     
-    // Store current highlights
-    currentHighlights.append(newHighlights);
+    if (isLargeFile()) {
+        largeFileView->goToLine(auditResults->line(row), auditResults->column(row), auditResults->columnKind(row));
+        statusBar()->showMessage(QString("%1 at line %2: %3")
+                                 .arg(auditResults->ruleId(row))
+                                 .arg(auditResults->line(row))
+                                 .arg(auditResults->issues(row).value(0)), 5000);
+        return;
+    }
     
-    // Get existing selections and add the new highlights
-    QList<QTextEdit::ExtraSelection> extraSelections = textEditor->extraSelections();
-    extraSelections.append(newHighlights);
-    textEditor->setExtraSelections(extraSelections);
+    QTextBlock block = textEditor->document()->findBlockByNumber(auditResults->line(row) - 1);
+    if (!block.isValid()) {
+        return;
+    }
     
-    // Move cursor to the highlighted issue for visibility
-    textEditor->setTextCursor(specificCursor);
+    QTextCursor cursor(block);
+    cursor.setPosition(EditorDecorator::columnPosition(block, auditResults->column(row), auditResults->columnKind(row)));
+    textEditor->setTextCursor(cursor);
     textEditor->ensureCursorVisible();
     
-    // Show prominent security notification
-    showSecurityNotification(result);
+    showSecurityNotification(auditResults->toResult(row));
+    statusBar()->showMessage(QString("%1 at line %2").arg(auditResults->ruleId(row)).arg(auditResults->line(row)), 5000);
+}
+
+/**
+ * @brief Shows a tooltip listing the findings of the hovered line.
+ * @param event The tooltip event received by the editor viewport.
+ * @return True if a tooltip was shown.
+ */
+bool MainWindow::showFindingToolTip(QHelpEvent* event) {
+    int fileId = findingIndex.fileId(currentFilePath);
+    if (findingIndex.findingCount(fileId) == 0) {
+        return false;
+    }
     
-    // Start animated blinking effect
-    animateHighlight(specificCursor, severity);
+    int line = textEditor->cursorForPosition(event->pos()).blockNumber() + 1;
+    QVector<int> rows = findingIndex.findingsAtLine(fileId, line);
+    if (rows.isEmpty()) {
+        QToolTip::hideText();
+        return false;
+    }
     
-    // Enhanced status message with emojis
-    QString severityIcon = isError ? "🔴" : (isWarning ? "🟡" : "🔵");
-    statusBar()->showMessage(QString("%1 SECURITY ISSUE: %2 at line %3 - CHECK NOTIFICATION ABOVE!")
-                           .arg(severityIcon)
-                           .arg(result.getRuleId())
-                           .arg(result.getLine()), 15000);
+    QStringList lines;
+    for (int row : rows) {
+        QString line = QString("🔍 %1 (%2)\n📝 %3")
+                           .arg(auditResults->ruleId(row))
+                           .arg(auditResults->toolName(row))
+                           .arg(auditResults->issues(row).value(0));
+        if (auditResults->isStale(row)) {
+            line += "\n⏳ Line changed since the last analysis";
+        }
+        lines << line;
+    }
+    QToolTip::showText(event->globalPos(), lines.join("\n\n"), textEditor->viewport());
+    return true;
 }
 
 /**
  * @brief Clears all security issue highlights from the text editor.
  */
 void MainWindow::clearSecurityHighlights() {
-    // Clear current highlights list
-    currentHighlights.clear();
-    
-    // Clear all extra selections (this will remove both search and security highlights)
-    textEditor->setExtraSelections(QList<QTextEdit::ExtraSelection>());
+    // Clear all decoration layers (this will remove both search and security highlights)
+    decorator->clearAll();
+    lineNumberArea->clearFindings();
+    overviewRuler->clearFindings();
+    largeFileView->clearFindings();
     
     // Stop any blinking animation
-    if (blinkTimer->isActive()) {
-        blinkTimer->stop();
-    }
+    emphasisOverlay->stop();
     
     // Hide notification
     hideSecurityNotification();
@@ -958,12 +1706,8 @@ void MainWindow::showSecurityNotification(const AuditResult& result) {
     createSecurityNotificationWidget();
     
     // Determine severity and set appropriate icon
-    QString ruleId = result.getRuleId();
-    bool isError = ruleId.contains("error", Qt::CaseInsensitive) || 
-                   result.getMessage().contains("error", Qt::CaseInsensitive);
-    bool isWarning = ruleId.contains("warning", Qt::CaseInsensitive) || 
-                     result.getMessage().contains("warning", Qt::CaseInsensitive) ||
-                     result.getMessage().contains("CWE", Qt::CaseInsensitive);
+    bool isError = result.getSeverity() == AuditResult::Error;
+    bool isWarning = result.getSeverity() == AuditResult::Warning;
     
     // Set icon based on severity
     QPixmap iconPixmap;
@@ -1006,6 +1750,20 @@ void MainWindow::showSecurityNotification(const AuditResult& result) {
                               .arg(result.getMessage().left(100) + (result.getMessage().length() > 100 ? "..." : ""))
                               .arg(result.getLine())
                               .arg(result.getColumn());
+    
+    // The code is read from the source, analyzers need not embed it. Findings of
+    // the open file were remapped to the edited buffer, so their line is read there
+    QString code;
+    const int fileId = findingIndex.fileId(currentFilePath);
+    if (!isLargeFile() && fileId >= 0 && findingIndex.fileId(result.getFilePath()) == fileId) {
+        QTextBlock block = textEditor->document()->findBlockByNumber(result.getLine() - 1);
+        code = block.isValid() ? block.text().left(MaxNotificationCodeLength).trimmed() : QString();
+    } else {
+        code = SnippetService::instance().lineText(result.getFilePath(), result.getLine()).trimmed();
+    }
+    if (!code.isEmpty()) {
+        notificationText += QString("<br>💻 <code>%1</code>").arg(code.toHtmlEscaped());
+    }
     securityNotificationText->setText(notificationText);
     
     // Update notification position and size
@@ -1051,56 +1809,15 @@ void MainWindow::hideSecurityNotification() {
  * @param severity The severity level for color selection.
  */
 void MainWindow::animateHighlight(const QTextCursor& cursor, const QString& severity) {
-    // Stop any existing blinking
-    if (blinkTimer->isActive()) {
-        blinkTimer->stop();
+    QColor color;
+    if (severity == "error") {
+        color = QColor(255, 0, 0);
+    } else if (severity == "warning") {
+        color = QColor(255, 165, 0);
+    } else {
+        color = QColor(0, 100, 255);
     }
     
-    // Store the cursor for blinking animation
-    QTextCursor animatedCursor = cursor;
-    
-    // Set up blinking timer
-    blinkState = false;
-    blinkTimer->setInterval(500); // Blink every 500ms
-    
-    // Create blinking effect
-    connect(blinkTimer, &QTimer::timeout, [this, animatedCursor, severity]() {
-        blinkState = !blinkState;
-        
-        if (blinkState) {
-            // Show enhanced highlight
-            QTextEdit::ExtraSelection blinkHighlight;
-            blinkHighlight.cursor = animatedCursor;
-            
-            if (severity == "error") {
-                blinkHighlight.format.setBackground(QColor(255, 0, 0, 200));
-                blinkHighlight.format.setForeground(QColor(255, 255, 255));
-            } else if (severity == "warning") {
-                blinkHighlight.format.setBackground(QColor(255, 165, 0, 200));
-                blinkHighlight.format.setForeground(QColor(255, 255, 255));
-            } else {
-                blinkHighlight.format.setBackground(QColor(0, 100, 255, 200));
-                blinkHighlight.format.setForeground(QColor(255, 255, 255));
-            }
-            
-            blinkHighlight.format.setFontWeight(QFont::Bold);
-            blinkHighlight.format.setProperty(QTextFormat::OutlinePen, QPen(QColor(0, 0, 0), 3));
-            
-            QList<QTextEdit::ExtraSelection> tempSelections = currentHighlights;
-            tempSelections.append(blinkHighlight);
-            textEditor->setExtraSelections(tempSelections);
-        } else {
-            // Hide enhanced highlight, show normal highlights
-            textEditor->setExtraSelections(currentHighlights);
-        }
-    });
-    
-    // Start blinking for 3 seconds
-    blinkTimer->start();
-    QTimer::singleShot(3000, [this]() {
-        if (blinkTimer->isActive()) {
-            blinkTimer->stop();
-            textEditor->setExtraSelections(currentHighlights);
-        }
-    });
+    // Blink for 3 seconds on the overlay, without touching the document
+    emphasisOverlay->start(cursor, color);
 }
\ No newline at end of file
@@ -0,0 +1,233 @@
+#include "../includes/mapped_text.hpp"
+#include <algorithm>
+#include <cstring>
+#include <QtAlgorithms>
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define MAPPED_TEXT_SSE2
+#endif
+
+/**
+ * @class MappedText
+ * @brief Read-only, memory-mapped text file with a line offset index.
+ *
+ * The file is mapped instead of read, so opening it costs no copy and pages
+ * are only loaded when lines are displayed. Opening scans the bytes once for
+ * newlines and records where every line starts; lines are then decoded on
+ * demand.
+ */
+
+MappedText::MappedText() : begin(nullptr), size(0), maxLineLength(0) {}
+
+MappedText::~MappedText() {
+    close();
+}
+
+/**
+ * @brief Maps a file and indexes its lines.
+ * @param path The file to open.
+ * @return True on success; errorString() describes the failure otherwise.
+ */
+bool MappedText::open(const QString& path) {
+    close();
+    file.setFileName(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    size = file.size();
+    if (size > 0) {
+        begin = reinterpret_cast<const char*>(file.map(0, size));
+        if (!begin) {
+            // Some file systems cannot be mapped
+            fallback = file.readAll();
+            begin = fallback.constData();
+            size = fallback.size();
+        }
+    }
+
+    scanNewlines(begin, size, lineStarts);
+    maxLineLength = 0;
+    for (int line = 0; line < lineStarts.size(); ++line) {
+        maxLineLength = int(qMax<qint64>(maxLineLength, lineLength(line)));
+    }
+    return true;
+}
+
+/**
+ * @brief Unmaps the file and drops the line index.
+ */
+void MappedText::close() {
+    if (file.isOpen()) {
+        file.close(); // Also unmaps
+    }
+    fallback.clear();
+    begin = nullptr;
+    size = 0;
+    lineStarts.clear();
+    maxLineLength = 0;
+}
+
+/**
+ * @brief Returns the length of a line, without its line terminator.
+ * @param line The line index (0-based).
+ * @return The length in bytes.
+ */
+qint64 MappedText::lineLength(int line) const {
+    qint64 end = line + 1 < lineStarts.size() ? lineStarts[line + 1] - 1 : size;
+    // The last line keeps the newline that ends the file
+    if (line + 1 == lineStarts.size() && end > lineStarts[line] && begin[end - 1] == '\n') {
+        --end;
+    }
+    if (end > lineStarts[line] && begin[end - 1] == '\r') {
+        --end;
+    }
+    return end - lineStarts[line];
+}
+
+/**
+ * @brief Finds the line containing a byte offset.
+ * @param offset The byte offset.
+ * @return The line index (0-based).
+ */
+int MappedText::lineAt(qint64 offset) const {
+    auto it = std::upper_bound(lineStarts.begin(), lineStarts.end(), offset);
+    return int(it - lineStarts.begin()) - 1;
+}
+
+/**
+ * @brief Decodes a line.
+ * @param line The line index (0-based).
+ * @param maxBytes The maximum number of bytes to decode, -1 for the whole line.
+ * @return The line text.
+ */
+QString MappedText::lineText(int line, int maxBytes) const {
+    qint64 length = lineLength(line);
+    if (maxBytes >= 0 && length > maxBytes) {
+        length = maxBytes;
+    }
+    return QString::fromUtf8(begin + lineStarts[line], int(length));
+}
+
+/**
+ * @brief Decodes part of a line.
+ *
+ * A start inside a multi-byte UTF-8 sequence is moved to the next character,
+ * so a slice of a very long line can be decoded on its own.
+ *
+ * @param line The line index (0-based).
+ * @param offset The byte offset of the slice in the line.
+ * @param maxBytes The maximum number of bytes to decode.
+ * @return The text of the slice.
+ */
+QString MappedText::lineText(int line, qint64 offset, int maxBytes) const {
+    const qint64 length = lineLength(line);
+    const char* start = begin + lineStarts[line];
+    offset = qBound<qint64>(0, offset, length);
+    while (offset < length && (uchar(start[offset]) & 0xC0) == 0x80) {
+        ++offset;
+    }
+    return QString::fromUtf8(start + offset, int(qMin<qint64>(maxBytes, length - offset)));
+}
+
+/**
+ * @brief Converts a column of a line to a byte offset in the line.
+ *
+ * Walks the UTF-8 lead bytes of the start of the line without decoding it,
+ * so a column far into a very long line costs no allocation. A column that
+ * falls inside a character maps to the start of the character.
+ *
+ * @param line The line index (0-based).
+ * @param column The column (1-based), in the given unit.
+ * @param kind The unit the column counts.
+ * @return The offset in bytes, at most the length of the line.
+ */
+qint64 MappedText::columnOffset(int line, int column, AuditResult::ColumnKind kind) const {
+    const qint64 length = lineLength(line);
+    const qint64 target = column - 1;
+    if (target <= 0) {
+        return 0;
+    }
+    if (kind == AuditResult::Utf8Bytes) {
+        return qMin(target, length);
+    }
+
+    const char* start = begin + lineStarts[line];
+    qint64 offset = 0;
+    qint64 count = 0;
+    while (offset < length) {
+        const int size = characterSize(start[offset]);
+        // Characters outside the BMP are a surrogate pair in UTF-16
+        const int units = kind == AuditResult::Utf16CodeUnits && size == 4 ? 2 : 1;
+        if (count + units > target) {
+            break;
+        }
+        count += units;
+        offset = qMin(offset + size, length);
+    }
+    return offset;
+}
+
+/**
+ * @brief Returns the number of bytes of the UTF-8 character starting with a byte.
+ * @param lead The first byte of the character.
+ * @return The size in bytes, 1 for ASCII and for invalid lead bytes.
+ */
+int MappedText::characterSize(char lead) {
+    const uchar byte = uchar(lead);
+    if ((byte & 0xE0) == 0xC0) {
+        return 2;
+    }
+    if ((byte & 0xF0) == 0xE0) {
+        return 3;
+    }
+    if ((byte & 0xF8) == 0xF0) {
+        return 4;
+    }
+    return 1;
+}
+
+/**
+ * @brief Records the start offset of every line of a buffer.
+ *
+ * Uses SSE2 to compare 16 bytes at a time against '\n' where available.
+ *
+ * @param data The buffer.
+ * @param size The size of the buffer in bytes.
+ * @param lineStarts Receives the offsets; the first line always starts at 0.
+ * @param vectorized False to search with memchr() alone, as the tests compare.
+ */
+void MappedText::scanNewlines(const char* data, qint64 size, QVector<qint64>& lineStarts, bool vectorized) {
+    lineStarts.clear();
+    lineStarts.reserve(int(qMin<qint64>(size / 32 + 1, 1 << 24)));
+    lineStarts.append(0);
+
+    qint64 i = 0;
+#ifdef MAPPED_TEXT_SSE2
+    const __m128i newline = _mm_set1_epi8('\n');
+    for (; vectorized && i + 16 <= size; i += 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        unsigned mask = unsigned(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, newline)));
+        while (mask) {
+            int bit = int(qCountTrailingZeroBits(mask));
+            lineStarts.append(i + bit + 1);
+            mask &= mask - 1;
+        }
+    }
+#else
+    Q_UNUSED(vectorized);
+#endif
+    for (; i < size; ++i) {
+        const char* found = static_cast<const char*>(std::memchr(data + i, '\n', size_t(size - i)));
+        if (!found) {
+            break;
+        }
+        i = found - data;
+        lineStarts.append(i + 1);
+    }
+
+    // A trailing newline does not start another line
+    if (lineStarts.size() > 1 && lineStarts.last() == size) {
+        lineStarts.removeLast();
+    }
+}
@@ -0,0 +1,296 @@
+#include "../includes/overview_ruler.hpp"
+#include <QPainter>
+#include <QPaintEvent>
+#include <QMouseEvent>
+#include <QScrollBar>
+#include <QTextBlock>
+#include <algorithm>
+#include <climits>
+
+/**
+ * @class OverviewRuler
+ * @brief Strip beside the editor scroll bar showing where the findings of the file are.
+ *
+ * The whole file is mapped onto the height of the ruler: every pixel row
+ * shows the highest severity of the findings on its lines, more opaque where
+ * findings accumulate. The rows are rendered into an image cached per
+ * document together with per-row counts. When the findings change, only the
+ * findings that were added or removed are applied to the counts and only the
+ * rows they touch are rendered again; scrolling just draws the cached image
+ * and the visible area. Clicking or dragging scrolls the editor.
+ */
+
+namespace {
+const int RulerWidth = 12;
+const int SeverityCount = 3;
+
+QColor severityColor(int severity) {
+    switch (severity) {
+    case AuditResult::Error:
+        return QColor(255, 0, 0);
+    case AuditResult::Warning:
+        return QColor(255, 165, 0);
+    default:
+        return QColor(0, 100, 255);
+    }
+}
+}
+
+bool OverviewRuler::Mark::operator<(const Mark& other) const {
+    if (line != other.line) {
+        return line < other.line;
+    }
+    if (endLine != other.endLine) {
+        return endLine < other.endLine;
+    }
+    return severity < other.severity;
+}
+
+bool OverviewRuler::Mark::operator==(const Mark& other) const {
+    return line == other.line && endLine == other.endLine && severity == other.severity;
+}
+
+/**
+ * @brief Creates the ruler of an editor.
+ * @param editor The editor whose document is shown.
+ */
+OverviewRuler::OverviewRuler(SourceEditor* editor)
+    : QWidget(editor)
+    , textEditor(editor)
+{
+    setFixedWidth(RulerWidth);
+    setCursor(Qt::PointingHandCursor);
+    connect(textEditor->verticalScrollBar(), &QScrollBar::valueChanged, this, QOverload<>::of(&QWidget::update));
+    connect(textEditor->verticalScrollBar(), &QScrollBar::rangeChanged, this, QOverload<>::of(&QWidget::update));
+    attachDocument();
+}
+
+/**
+ * @brief Follows the document currently shown by the editor.
+ *
+ * Must be called again whenever the editor is given another document. The
+ * cached ruler of a document is dropped when the document is deleted.
+ */
+void OverviewRuler::attachDocument() {
+    QTextDocument* document = textEditor->document();
+    cache();
+    connect(document, &QTextDocument::blockCountChanged, this, QOverload<>::of(&QWidget::update), Qt::UniqueConnection);
+    update();
+}
+
+/**
+ * @brief Sets the findings shown for the current document.
+ *
+ * Only the difference to the findings shown before is applied.
+ *
+ * @param findings The findings the index was built from.
+ * @param index The finding index.
+ * @param fileId The index ID of the file shown in the editor, -1 if none.
+ */
+void OverviewRuler::setFindings(const FindingSnapshot& findings, const FindingIndex* index, int fileId) {
+    QVector<Mark> marks;
+    if (index && fileId >= 0) {
+        for (int row : index->findingsInRange(fileId, 1, INT_MAX)) {
+            if (!findings->ruleId(row).isEmpty()) {
+                int line = findings->line(row);
+                marks.append(Mark{line, qMax(findings->endLine(row), line), int(findings->severity(row))});
+            }
+        }
+    }
+    updateMarks(marks);
+}
+
+/**
+ * @brief Removes the findings of the current document.
+ */
+void OverviewRuler::clearFindings() {
+    updateMarks(QVector<Mark>());
+}
+
+QSize OverviewRuler::sizeHint() const {
+    return QSize(RulerWidth, 0);
+}
+
+/**
+ * @brief Returns the ruler state of the current document.
+ * @return The cache entry, created if needed.
+ */
+OverviewRuler::Cache& OverviewRuler::cache() {
+    QTextDocument* document = textEditor->document();
+    auto it = caches.find(document);
+    if (it == caches.end()) {
+        connect(document, &QObject::destroyed, this, [this](QObject* object) { caches.remove(object); });
+        it = caches.insert(document, Cache());
+    }
+    return it.value();
+}
+
+/**
+ * @brief Replaces the marks of the current document, rendering only the rows that changed.
+ * @param marks The new marks, in any order.
+ */
+void OverviewRuler::updateMarks(QVector<Mark> marks) {
+    std::sort(marks.begin(), marks.end());
+    Cache& current = cache();
+    if (marks == current.marks) {
+        return;
+    }
+
+    if (current.image.height() != height() || current.lineCount != textEditor->document()->blockCount()) {
+        current.marks = marks;
+        rebuild(current);
+        update();
+        return;
+    }
+
+    // Both lists are sorted, so one merge finds what was removed and what was added
+    QVector<bool> dirtyRows(current.image.height(), false);
+    auto oldIt = current.marks.constBegin();
+    auto newIt = marks.constBegin();
+    while (oldIt != current.marks.constEnd() || newIt != marks.constEnd()) {
+        if (newIt == marks.constEnd() || (oldIt != current.marks.constEnd() && *oldIt < *newIt)) {
+            addMark(current, *oldIt++, -1, dirtyRows);
+        } else if (oldIt == current.marks.constEnd() || *newIt < *oldIt) {
+            addMark(current, *newIt++, 1, dirtyRows);
+        } else {
+            ++oldIt;
+            ++newIt;
+        }
+    }
+    current.marks = marks;
+
+    for (int row = 0; row < dirtyRows.size(); ++row) {
+        if (dirtyRows[row]) {
+            renderRow(current, row);
+        }
+    }
+    update();
+}
+
+/**
+ * @brief Recomputes the counts and the image of a document from its marks.
+ * @param cache The ruler state to rebuild.
+ */
+void OverviewRuler::rebuild(Cache& cache) {
+    cache.lineCount = textEditor->document()->blockCount();
+    cache.image = QImage(qMax(1, width()), qMax(1, height()), QImage::Format_ARGB32_Premultiplied);
+    cache.image.fill(Qt::transparent);
+    cache.counts.fill(0, cache.image.height() * SeverityCount);
+
+    QVector<bool> dirtyRows(cache.image.height(), false);
+    for (const Mark& mark : cache.marks) {
+        addMark(cache, mark, 1, dirtyRows);
+    }
+    for (int row = 0; row < dirtyRows.size(); ++row) {
+        if (dirtyRows[row]) {
+            renderRow(cache, row);
+        }
+    }
+}
+
+/**
+ * @brief Adds or removes a mark from the per-row counts.
+ * @param cache The ruler state to update.
+ * @param mark The mark.
+ * @param delta 1 to add the mark, -1 to remove it.
+ * @param dirtyRows Set for every row whose count changed.
+ */
+void OverviewRuler::addMark(Cache& cache, const Mark& mark, int delta, QVector<bool>& dirtyRows) {
+    int first = rowForLine(cache, mark.line);
+    int last = rowForLine(cache, mark.endLine);
+    for (int row = first; row <= last; ++row) {
+        quint16& count = cache.counts[row * SeverityCount + mark.severity];
+        count = quint16(qMax(0, int(count) + delta));
+        dirtyRows[row] = true;
+    }
+}
+
+/**
+ * @brief Renders one pixel row of the cached image from its counts.
+ * @param cache The ruler state.
+ * @param row The pixel row.
+ */
+void OverviewRuler::renderRow(Cache& cache, int row) {
+    int severity = -1;
+    int total = 0;
+    for (int i = 0; i < SeverityCount; ++i) {
+        int count = cache.counts[row * SeverityCount + i];
+        total += count;
+        if (count > 0) {
+            severity = i;
+        }
+    }
+
+    QRgb* line = reinterpret_cast<QRgb*>(cache.image.scanLine(row));
+    QRgb pixel = 0;
+    if (severity >= 0) {
+        QColor color = severityColor(severity);
+        color.setAlpha(qMin(255, 120 + 45 * total)); // Denser rows are more opaque
+        pixel = qPremultiply(color.rgba());
+    }
+    // Leave a one pixel margin on both sides
+    for (int x = 0; x < cache.image.width(); ++x) {
+        line[x] = x == 0 || x == cache.image.width() - 1 ? 0 : pixel;
+    }
+}
+
+/**
+ * @brief Maps a line onto a pixel row of the ruler.
+ * @param cache The ruler state.
+ * @param line The line number (1-based).
+ * @return The pixel row.
+ */
+int OverviewRuler::rowForLine(const Cache& cache, int line) const {
+    int rows = cache.image.height();
+    int lines = qMax(1, cache.lineCount);
+    return qBound(0, int(qint64(line - 1) * rows / lines), rows - 1);
+}
+
+void OverviewRuler::paintEvent(QPaintEvent* event) {
+    Q_UNUSED(event);
+    Cache& current = cache();
+    if (current.image.height() != height() || current.image.width() != width() ||
+        current.lineCount != textEditor->document()->blockCount()) {
+        rebuild(current);
+    }
+
+    QPainter painter(this);
+    painter.fillRect(rect(), palette().window());
+
+    // Visible part of the document
+    QScrollBar* scrollBar = textEditor->verticalScrollBar();
+    int total = scrollBar->maximum() + scrollBar->pageStep();
+    if (total > scrollBar->pageStep()) {
+        int top = int(qint64(scrollBar->value()) * height() / total);
+        int span = qMax(4, int(qint64(scrollBar->pageStep()) * height() / total));
+        QColor shade = palette().text().color();
+        shade.setAlpha(40);
+        painter.fillRect(QRect(0, top, width(), span), shade);
+    }
+
+    painter.drawImage(0, 0, current.image);
+}
+
+void OverviewRuler::mousePressEvent(QMouseEvent* event) {
+    scrollToY(event->pos().y());
+}
+
+void OverviewRuler::mouseMoveEvent(QMouseEvent* event) {
+    if (event->buttons() & Qt::LeftButton) {
+        scrollToY(event->pos().y());
+    }
+}
+
+/**
+ * @brief Centers the editor on the line under a ruler position.
+ * @param y The vertical position in the ruler.
+ */
+void OverviewRuler::scrollToY(int y) {
+    QTextDocument* document = textEditor->document();
+    int line = int(qint64(qBound(0, y, height() - 1)) * document->blockCount() / qMax(1, height()));
+    QTextBlock block = document->findBlockByNumber(line);
+    if (!block.isValid()) {
+        return;
+    }
+    textEditor->centerOnBlock(block);
+}
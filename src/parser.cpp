@@ -1,4 +1,5 @@
 #include "../includes/parser.hpp"
+#include "../includes/finding_index.hpp"
 #include <QStringList>
 #include <QJsonDocument>
 #include <QJsonObject>
@@ -6,6 +7,44 @@
 #include <QString>
 #include <QList>
 #include <QRegularExpression>
+#include <QHash>
+
+namespace {
+/**
+ * @brief Feeds a string into a 64-bit FNV-1a hash.
+ * @param hash The running hash.
+ * @param text The string to add.
+ * @return The updated hash.
+ */
+quint64 hashText(quint64 hash, const QString& text) {
+    const ushort* data = text.utf16();
+    for (int i = 0; i < text.length(); ++i) {
+        hash = (hash ^ data[i]) * 1099511628211ULL;
+    }
+    // Separator so that ("ab", "c") and ("a", "bc") differ
+    return (hash ^ 0xFFFFu) * 1099511628211ULL;
+}
+
+/**
+ * @brief Reads the unit of the columns of a SARIF run.
+ *
+ * SARIF defines UTF-16 code units, the default, and Unicode code points;
+ * some tools report UTF-8 byte offsets instead.
+ *
+ * @param run The run object.
+ * @return The column unit.
+ */
+AuditResult::ColumnKind columnKind(const QJsonObject& run) {
+    QString kind = run["columnKind"].toString();
+    if (kind == "unicodeCodePoints") {
+        return AuditResult::UnicodeCodePoints;
+    }
+    if (kind == "utf8Bytes" || kind == "bytes") {
+        return AuditResult::Utf8Bytes;
+    }
+    return AuditResult::Utf16CodeUnits;
+}
+}
 
 /**
  * @brief Parses the given output string and extracts SARIF results.
@@ -13,8 +52,35 @@
  * @return A list of AuditResults with parsed findings.
  */
 QList<AuditResult> Parser::parse(const QString& output) {
-    QList<AuditResult> results;
     bool foundResults = false;
+    QList<AuditResult> results = parseFindings(output, foundResults);
+    
+    // If no security issues were found, show a success message
+    if (!foundResults) {
+        results.append(noIssuesResult());
+    }
+    
+    return results;
+}
+
+/**
+ * @brief Extracts the SARIF findings from the given output string.
+ *
+ * Unlike parse(), no placeholder result is added when nothing is found, so
+ * the findings of several runs can be concatenated.
+ *
+ * @param output The output string to parse.
+ * @param foundResults Set to true if at least one SARIF run was parsed.
+ * @param runTools If not null, receives the driver name of every parsed run,
+ * including runs without findings.
+ * @return A list of AuditResults with parsed findings.
+ */
+QList<AuditResult> Parser::parseFindings(const QString& output, bool& foundResults, QStringList* runTools) {
+    QList<AuditResult> results;
+    foundResults = false;
+    if (runTools) {
+        runTools->clear();
+    }
     
     // Find JSON blocks that contain SARIF-related content
     for (int i = 0; i < output.length(); i++) {
@@ -42,7 +108,7 @@ QList<AuditResult> Parser::parse(const QString& output) {
                     
                     QJsonDocument doc = QJsonDocument::fromJson(jsonStr.toUtf8());
                     if (!doc.isNull() && doc.isObject()) {
-                        parseSarifDocument(doc.object(), results, foundResults);
+                        parseSarifDocument(doc.object(), results, foundResults, runTools);
                     }
                     
                     // Continue searching from after this JSON block
@@ -52,22 +118,26 @@ QList<AuditResult> Parser::parse(const QString& output) {
         }
     }
     
-    // If no security issues were found, show a success message
-    if (!foundResults) {
-        AuditResult* result = new AuditResult("Security Analysis Complete");
-        result->addIssue("✅ No security issues detected");
-        result->addIssue("All static analysis tools completed successfully");
-        results.append(*result);
-        delete result;
-    }
-    
     return results;
 }
 
-void Parser::parseSarifDocument(const QJsonObject& sarifObj, QList<AuditResult>& results, bool& foundResults) {
+/**
+ * @brief Builds the result shown when an analysis reported no findings.
+ * @return An AuditResult without location information.
+ */
+AuditResult Parser::noIssuesResult() {
+    AuditResult result("Security Analysis Complete");
+    result.addIssue("✅ No security issues detected");
+    result.addIssue("All static analysis tools completed successfully");
+    return result;
+}
+
+void Parser::parseSarifDocument(const QJsonObject& sarifObj, QList<AuditResult>& results, bool& foundResults,
+                                QStringList* runTools) {
     // Check if this is a SARIF document
     if (sarifObj.contains("runs") && sarifObj["runs"].isArray()) {
         QJsonArray runs = sarifObj["runs"].toArray();
+        QHash<quint64, QList<quint64>> occurrenceLocations;
         
         for (int runIndex = 0; runIndex < runs.size(); runIndex++) {
             QJsonObject run = runs[runIndex].toObject();
@@ -81,10 +151,14 @@ void Parser::parseSarifDocument(const QJsonObject& sarifObj, QList<AuditResult>&
                     toolName = driver["name"].toString();
                 }
             }
+            const AuditResult::ColumnKind runColumnKind = columnKind(run);
             
             // Parse results
             if (run.contains("results") && run["results"].isArray()) {
                 QJsonArray resultsArray = run["results"].toArray();
+                if (runTools) {
+                    runTools->append(toolName);
+                }
                 
                 if (resultsArray.isEmpty()) {
                     // No issues found by this tool - don't create a result, just mark as found
@@ -105,11 +179,22 @@ void Parser::parseSarifDocument(const QJsonObject& sarifObj, QList<AuditResult>&
                         int endLineNumber = 0;
                         int endColumnNumber = 0;
                         QString snippet = "";
+                        QString logicalContext;
                         
                         if (resultObj.contains("locations") && resultObj["locations"].isArray()) {
                             QJsonArray locations = resultObj["locations"].toArray();
                             if (!locations.isEmpty()) {
                                 QJsonObject location = locations[0].toObject();
+                                
+                                // Get the enclosing function or scope, if reported
+                                QJsonArray logicalLocations = location["logicalLocations"].toArray();
+                                if (!logicalLocations.isEmpty()) {
+                                    QJsonObject logical = logicalLocations[0].toObject();
+                                    logicalContext = logical.contains("fullyQualifiedName")
+                                        ? logical["fullyQualifiedName"].toString()
+                                        : logical["name"].toString();
+                                }
+
                                 if (location.contains("physicalLocation")) {
                                     QJsonObject physLocation = location["physicalLocation"].toObject();
                                     
@@ -119,7 +204,8 @@ void Parser::parseSarifDocument(const QJsonObject& sarifObj, QList<AuditResult>&
                                         fileName = artifact["uri"].toString();
                                     }
                                     
-                                    // Get detailed line/column information and snippet
+                                    // Get detailed line/column information, and the snippet if embedded
+                                    // (only used for the fingerprint, views read the code from the source)
                                     if (physLocation.contains("region")) {
                                         QJsonObject region = physLocation["region"].toObject();
                                         lineNumber = region["startLine"].toInt();
@@ -142,7 +228,26 @@ void Parser::parseSarifDocument(const QJsonObject& sarifObj, QList<AuditResult>&
                         result->setColumn(columnNumber);
                         result->setEndLine(endLineNumber > 0 ? endLineNumber : lineNumber);
                         result->setEndColumn(endColumnNumber > 0 ? endColumnNumber : columnNumber + 10);
+                        result->setColumnKind(runColumnKind);
                         result->setRuleId(ruleId);
+                        result->setToolName(toolName);
+                        result->setLevel(level);
+                        
+                        // The same code in the same scope may be flagged more than once, on
+                        // one line or several; tell those occurrences apart by their order,
+                        // which survives edits
+                        quint64 fingerprint = computeFingerprint(resultObj, ruleId, fileName, snippet, message, logicalContext);
+                        const quint64 location = (quint64(quint32(lineNumber)) << 32) | quint32(columnNumber);
+                        QList<quint64>& occurrences = occurrenceLocations[fingerprint];
+                        int occurrence = occurrences.indexOf(location);
+                        if (occurrence < 0) {
+                            occurrence = occurrences.size();
+                            occurrences.append(location);
+                        }
+                        if (occurrence > 0) {
+                            fingerprint = hashText(fingerprint, QString::number(occurrence));
+                        }
+                        result->setFingerprint(fingerprint ? fingerprint : 1);
                         
                         // Format the issue description with precise location
                         if (columnNumber > 0) {
@@ -165,10 +270,6 @@ void Parser::parseSarifDocument(const QJsonObject& sarifObj, QList<AuditResult>&
                         
                         result->addIssue(QString("%1 Severity: %2").arg(severityIcon).arg(level.isEmpty() ? "unknown" : level));
                         
-                        if (!snippet.isEmpty()) {
-                            result->addIssue(QString("💻 Code: %1").arg(snippet.trimmed()));
-                        }
-                        
                         // Add security recommendation if it's a security issue
                         if (message.contains("CWE") || ruleId.contains("security") || ruleId.contains("vuln")) {
                             result->addIssue("🛡️  Recommendation: Review this code for potential security vulnerabilities");
@@ -184,4 +285,48 @@ void Parser::parseSarifDocument(const QJsonObject& sarifObj, QList<AuditResult>&
     }
 }
 
+/**
+ * @brief Computes a stable identity for a finding.
+ *
+ * The fingerprint always combines the rule and the normalized path of the
+ * file, since tools may compute their fingerprints per file. Fingerprints
+ * supplied by the tool (SARIF "fingerprints" or "partialFingerprints") are
+ * added when present. Otherwise the fingerprint adds the normalized snippet
+ * (or the message with numbers removed, since they usually are line numbers)
+ * and the enclosing logical location. Line numbers are deliberately left out
+ * so the same issue keeps its identity when code moves between runs.
+ *
+ * @param resultObj The SARIF result object.
+ * @param ruleId The rule ID of the finding.
+ * @param fileName The artifact URI of the finding.
+ * @param snippet The code snippet, if any.
+ * @param message The message text.
+ * @param context The enclosing logical location, if any.
+ * @return The 64-bit fingerprint, never 0.
+ */
+quint64 Parser::computeFingerprint(const QJsonObject& resultObj, const QString& ruleId, const QString& fileName,
+                                   const QString& snippet, const QString& message, const QString& context) {
+    quint64 hash = 14695981039346656037ULL;
+    hash = hashText(hash, ruleId);
+    hash = hashText(hash, FindingIndex::normalizePath(fileName));
+    
+    for (const char* key : {"fingerprints", "partialFingerprints"}) {
+        QJsonObject fingerprints = resultObj[key].toObject();
+        if (!fingerprints.isEmpty()) {
+            // QJsonObject keys are sorted, so the order is stable
+            for (auto it = fingerprints.constBegin(); it != fingerprints.constEnd(); ++it) {
+                hash = hashText(hash, it.key());
+                hash = hashText(hash, it.value().toString());
+            }
+            return hash ? hash : 1;
+        }
+    }
+    
+    static const QRegularExpression numbers("\\d+");
+    QString text = snippet.isEmpty() ? QString(message).remove(numbers) : snippet;
+    hash = hashText(hash, text.simplified());
+    hash = hashText(hash, context);
+    return hash ? hash : 1;
+}
+
 Parser::~Parser() {}
@@ -0,0 +1,337 @@
+#include "../includes/project_search.hpp"
+#include <QRunnable>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QRegularExpression>
+#include <QAtomicInt>
+#include <QMetaObject>
+#include <QThread>
+#include <algorithm>
+#include <functional>
+#include <cstring>
+
+/**
+ * @class ProjectSearch
+ * @brief Parallel find-in-files over the project tree.
+ *
+ * One task walks the directory tree, skipping version control and build
+ * directories, and queues every candidate file on a thread pool sized to the
+ * machine. Files are memory-mapped rather than read. Binary files are
+ * recognized by a NUL byte in their first block and skipped. Case-sensitive
+ * literal queries are matched directly on the raw UTF-8 bytes with a
+ * Boyer-Moore-Horspool searcher, and a file is only decoded around its
+ * matches. Other queries decode the file and fall back to a regular
+ * expression. Matches are posted to the UI thread file by file as they are
+ * found. A new search cancels the previous one, whose pending results are
+ * dropped.
+ */
+
+namespace {
+const qint64 MaxFileSize = 64 * 1024 * 1024;
+const int BinaryProbeSize = 8192;
+const int MaxMatchesPerFile = 1000;
+const int MaxMatches = 100000;
+const int MaxPreviewLength = 200;
+
+class FunctionTask : public QRunnable {
+public:
+    explicit FunctionTask(const std::function<void()>& function) : function(function) {}
+    void run() override { function(); }
+
+private:
+    std::function<void()> function;
+};
+
+bool isBinaryExtension(const QString& suffix) {
+    static const QStringList extensions = {
+        "a", "bin", "bmp", "class", "dll", "dylib", "exe", "gif", "gz", "ico", "jar", "jpeg",
+        "jpg", "lib", "o", "obj", "pdf", "png", "pyc", "so", "tar", "ttf", "woff", "xz", "zip"
+    };
+    return extensions.contains(suffix.toLower());
+}
+}
+
+struct ProjectSearch::State {
+    int id;
+    ProjectSearch* owner;
+    QThreadPool* pool;
+    QByteArray literal;
+    QRegularExpression expression;
+    QAtomicInt cancelled;
+    QAtomicInt pending;
+    QAtomicInt filesSearched;
+    QAtomicInt matchCount;
+
+    bool isCancelled() const { return cancelled.loadAcquire() != 0; }
+};
+
+namespace {
+/**
+ * @brief Builds a match from its position in a line.
+ * @param path The file path.
+ * @param line The line number (1-based).
+ * @param lineText The text of the line.
+ * @param column The column of the match in the line (0-based, in characters).
+ * @param length The length of the match in characters.
+ * @return The match.
+ */
+FileMatch makeMatch(const QString& path, int line, const QString& lineText, int column, int length) {
+    FileMatch match;
+    match.filePath = path;
+    match.line = line;
+    match.column = column + 1;
+    match.length = length;
+    match.preview = lineText.trimmed().left(MaxPreviewLength);
+    return match;
+}
+
+/**
+ * @brief Finds a case-sensitive literal in the raw bytes of a file.
+ */
+void scanBytes(const QString& path, const char* begin, const char* end, const QByteArray& literal,
+               const ProjectSearch::State& state, QVector<FileMatch>& matches) {
+    std::boyer_moore_horspool_searcher<const char*> searcher(literal.constData(), literal.constData() + literal.size());
+    const int length = QString::fromUtf8(literal).length();
+
+    int line = 1;
+    const char* lineStart = begin;
+    for (const char* hit = std::search(begin, end, searcher); hit != end;
+         hit = std::search(hit + literal.size(), end, searcher)) {
+        // Count the lines up to the match
+        while (const char* newline = static_cast<const char*>(std::memchr(lineStart, '\n', hit - lineStart))) {
+            ++line;
+            lineStart = newline + 1;
+        }
+        const char* lineEnd = static_cast<const char*>(std::memchr(hit, '\n', end - hit));
+        if (!lineEnd) {
+            lineEnd = end;
+        }
+
+        QString lineText = QString::fromUtf8(lineStart, int(lineEnd - lineStart));
+        int column = QString::fromUtf8(lineStart, int(hit - lineStart)).length();
+        matches.append(makeMatch(path, line, lineText, column, length));
+        if (matches.size() >= MaxMatchesPerFile || state.isCancelled()) {
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Finds a regular expression in the decoded text of a file.
+ */
+void scanText(const QString& path, const QString& text, const QRegularExpression& expression,
+              const ProjectSearch::State& state, QVector<FileMatch>& matches) {
+    int line = 1;
+    int lineStart = 0;
+    QRegularExpressionMatchIterator it = expression.globalMatch(text);
+    while (it.hasNext()) {
+        QRegularExpressionMatch match = it.next();
+        if (match.capturedLength() == 0) {
+            continue;
+        }
+        int position = match.capturedStart();
+        for (int newline = text.indexOf('\n', lineStart); newline >= 0 && newline < position;
+             newline = text.indexOf('\n', lineStart)) {
+            ++line;
+            lineStart = newline + 1;
+        }
+        int lineEnd = text.indexOf('\n', position);
+        QString lineText = text.mid(lineStart, lineEnd < 0 ? -1 : lineEnd - lineStart);
+        matches.append(makeMatch(path, line, lineText, position - lineStart, match.capturedLength()));
+        if (matches.size() >= MaxMatchesPerFile || state.isCancelled()) {
+            break;
+        }
+    }
+}
+}
+
+/**
+ * @brief Constructs a project search with a thread pool sized to the machine.
+ * @param parent The parent object.
+ */
+ProjectSearch::ProjectSearch(QObject* parent)
+    : QObject(parent)
+    , generation(0)
+    , matchCount(0)
+    , running(false)
+{
+    pool.setMaxThreadCount(qMax(2, QThread::idealThreadCount()));
+}
+
+/**
+ * @brief Cancels the running search and waits for the workers to stop.
+ */
+ProjectSearch::~ProjectSearch() {
+    cancel();
+    pool.waitForDone();
+}
+
+/**
+ * @brief Returns the directory names never searched.
+ * @return The directory names.
+ */
+QStringList ProjectSearch::ignoredDirectories() {
+    return QStringList() << "build" << "node_modules" << "CMakeFiles" << "__pycache__";
+}
+
+/**
+ * @brief Starts searching every text file below a directory.
+ *
+ * Any search in progress is cancelled. Hidden files and directories are
+ * skipped along with ignoredDirectories().
+ *
+ * @param rootPath The directory to search.
+ * @param query The pattern and search options.
+ */
+void ProjectSearch::search(const QString& rootPath, const SearchEngine::Query& query) {
+    cancel();
+    matchCount = 0;
+    if (query.pattern.isEmpty()) {
+        emit finished(0, 0, QString());
+        return;
+    }
+
+    QSharedPointer<State> search(new State());
+    search->id = ++generation;
+    search->owner = this;
+    search->pool = &pool;
+    search->pending.storeRelaxed(1); // The directory walk itself
+    if (query.caseSensitive && !query.regularExpression) {
+        search->literal = query.pattern.toUtf8();
+    } else {
+        QString pattern = query.regularExpression ? query.pattern : QRegularExpression::escape(query.pattern);
+        QRegularExpression::PatternOptions options = QRegularExpression::MultilineOption;
+        if (!query.caseSensitive) {
+            options |= QRegularExpression::CaseInsensitiveOption;
+        }
+        search->expression = QRegularExpression(pattern, options);
+        if (!search->expression.isValid()) {
+            emit finished(0, 0, search->expression.errorString());
+            return;
+        }
+        search->expression.optimize();
+    }
+    state = search;
+    running = true;
+
+    // Called by every task when it is done; the last one reports completion
+    auto release = [](const QSharedPointer<State>& search) {
+        if (!search->pending.deref() && !search->isCancelled()) {
+            int id = search->id;
+            int files = search->filesSearched.loadAcquire();
+            ProjectSearch* owner = search->owner;
+            QMetaObject::invokeMethod(owner, [owner, id, files]() { owner->finish(id, files, QString()); },
+                                      Qt::QueuedConnection);
+        }
+    };
+
+    auto scanFile = [release](const QSharedPointer<State>& search, const QString& path) {
+        QVector<FileMatch> matches;
+        QFile file(path);
+        qint64 size = file.size();
+        if (!search->isCancelled() && size > 0 && size <= MaxFileSize && file.open(QIODevice::ReadOnly)) {
+            QByteArray buffer;
+            const char* begin = reinterpret_cast<const char*>(file.map(0, size));
+            if (!begin) {
+                buffer = file.readAll();
+                begin = buffer.constData();
+                size = buffer.size();
+            }
+            const char* end = begin + size;
+
+            if (!std::memchr(begin, 0, size_t(qMin<qint64>(size, BinaryProbeSize)))) {
+                search->filesSearched.ref();
+                if (!search->literal.isEmpty()) {
+                    scanBytes(path, begin, end, search->literal, *search, matches);
+                } else {
+                    scanText(path, QString::fromUtf8(begin, int(size)), search->expression, *search, matches);
+                }
+            }
+        }
+
+        if (!matches.isEmpty() && !search->isCancelled()) {
+            if (search->matchCount.fetchAndAddRelaxed(matches.size()) + matches.size() >= MaxMatches) {
+                // Too many results: stop here and report what was found
+                search->cancelled.storeRelease(1);
+                int id = search->id;
+                int files = search->filesSearched.loadAcquire();
+                ProjectSearch* owner = search->owner;
+                QMetaObject::invokeMethod(owner, [owner, id, matches, files]() {
+                    owner->deliver(id, matches);
+                    owner->finish(id, files, QString("Stopped after %1 matches").arg(MaxMatches));
+                }, Qt::QueuedConnection);
+            } else {
+                int id = search->id;
+                ProjectSearch* owner = search->owner;
+                QMetaObject::invokeMethod(owner, [owner, id, matches]() { owner->deliver(id, matches); },
+                                          Qt::QueuedConnection);
+            }
+        }
+        release(search);
+    };
+
+    auto walk = [release, scanFile](const QSharedPointer<State>& search, const QString& rootPath) {
+        const QStringList ignored = ignoredDirectories();
+        QStringList directories(rootPath);
+        while (!directories.isEmpty() && !search->isCancelled()) {
+            QDir directory(directories.takeLast());
+            const QFileInfoList entries = directory.entryInfoList(
+                QDir::Dirs | QDir::Files | QDir::NoDotAndDotDot | QDir::NoSymLinks, QDir::Name);
+            for (const QFileInfo& entry : entries) {
+                if (entry.isDir()) {
+                    if (!ignored.contains(entry.fileName())) {
+                        directories.append(entry.filePath());
+                    }
+                } else if (!isBinaryExtension(entry.suffix())) {
+                    search->pending.ref();
+                    QString path = entry.filePath();
+                    search->pool->start(new FunctionTask([scanFile, search, path]() { scanFile(search, path); }));
+                }
+            }
+        }
+        release(search);
+    };
+
+    pool.start(new FunctionTask([walk, search, rootPath]() { walk(search, rootPath); }));
+}
+
+/**
+ * @brief Stops the running search. Results already delivered are kept.
+ */
+void ProjectSearch::cancel() {
+    if (state) {
+        state->cancelled.storeRelease(1);
+        state.clear();
+    }
+    pool.clear();
+    running = false;
+}
+
+/**
+ * @brief Forwards the matches of a file to the UI.
+ * @param id The ID of the search that found the matches.
+ * @param matches The matches of one file.
+ */
+void ProjectSearch::deliver(int id, const QVector<FileMatch>& matches) {
+    if (id != generation || !running) {
+        return; // Stale search
+    }
+    matchCount += matches.size();
+    emit matchesFound(matches);
+}
+
+/**
+ * @brief Reports the end of a search.
+ * @param id The ID of the finished search.
+ * @param filesSearched The number of text files scanned.
+ * @param error The reason the search stopped early, empty on success.
+ */
+void ProjectSearch::finish(int id, int filesSearched, const QString& error) {
+    if (id != generation || !running) {
+        return;
+    }
+    running = false;
+    state.clear();
+    emit finished(filesSearched, matchCount, error);
+}
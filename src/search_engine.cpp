@@ -0,0 +1,293 @@
+#include "../includes/search_engine.hpp"
+#include <QRunnable>
+#include <QStringMatcher>
+#include <QRegularExpression>
+#include <QMetaObject>
+#include <algorithm>
+#include <functional>
+
+/**
+ * @class SearchEngine
+ * @brief Searches a snapshot of the editor text on a worker thread.
+ *
+ * Each search scans an implicitly shared copy of the text, so the editor
+ * stays responsive while multi-megabyte files are searched. Matches are
+ * streamed back to the UI thread in batches and appended to a sorted index
+ * (the scan runs front to back), which serves viewport and next/previous
+ * lookups with binary searches. Starting a new search bumps a generation
+ * counter: the previous scan notices it and stops, and its late batches are
+ * ignored.
+ */
+
+namespace {
+const int BatchSize = 4096;
+
+// Searches check for cancellation after each chunk of this many characters
+const int SearchChunkSize = 64 * 1024;
+
+// How far past the end of a range a regular expression match may run, then to the end of
+// that line if it ends within as many characters again
+const int MaxMatchSpan = 4096;
+
+class SearchTask : public QRunnable {
+public:
+    SearchTask(const QString& text, const SearchEngine::Query& query,
+               const QSharedPointer<QAtomicInt>& generation,
+               const std::function<void(int, const QVector<TextMatch>&)>& deliver,
+               const std::function<void(int, const QString&)>& finish)
+        : text(text), query(query), generation(generation),
+          id(generation->loadAcquire()), deliver(deliver), finish(finish) {}
+
+    void run() override {
+        QVector<TextMatch> batch;
+        batch.reserve(BatchSize);
+        auto flush = [&]() {
+            if (!batch.isEmpty()) {
+                deliver(id, batch);
+                batch.clear();
+            }
+        };
+
+        TextMatcher matcher(query);
+        if (!matcher.isValid()) {
+            finish(id, matcher.errorString());
+            return;
+        }
+        // The text is scanned chunk by chunk so a cancelled search stops
+        // quickly, even without matches or with a slow regular expression
+        const int chunkSize = SearchChunkSize;
+        int length = 0;
+        int next = 0;
+        for (int start = 0; start < text.size(); start += qMin(chunkSize, text.size() - start)) {
+            int end = start + qMin(chunkSize, text.size() - start);
+            for (int position = matcher.indexIn(text, qMax(start, next), end, length); position >= 0;
+                 position = matcher.indexIn(text, next, end, length)) {
+                next = position + length;
+                batch.append(TextMatch{position, length});
+                if (batch.size() == BatchSize) {
+                    if (cancelled()) {
+                        return;
+                    }
+                    flush();
+                }
+            }
+            if (cancelled()) {
+                return;
+            }
+        }
+        flush();
+        finish(id, QString());
+    }
+
+private:
+    bool cancelled() const {
+        return generation->loadAcquire() != id;
+    }
+
+    QString text;
+    SearchEngine::Query query;
+    QSharedPointer<QAtomicInt> generation;
+    int id;
+    std::function<void(int, const QVector<TextMatch>&)> deliver;
+    std::function<void(int, const QString&)> finish;
+};
+}
+
+/**
+ * @brief Constructs a search engine with its own worker thread.
+ * @param parent The parent object.
+ */
+SearchEngine::SearchEngine(QObject* parent)
+    : QObject(parent)
+    , generation(new QAtomicInt(0))
+    , running(false)
+{
+    pool.setMaxThreadCount(1);
+}
+
+/**
+ * @brief Cancels the running search and waits for the worker to stop.
+ */
+SearchEngine::~SearchEngine() {
+    cancel();
+    pool.waitForDone();
+}
+
+/**
+ * @brief Starts searching a text, cancelling any search in progress.
+ *
+ * The matches are cleared immediately and refilled as batches arrive.
+ *
+ * @param text The text to search. Only a shallow copy is taken.
+ * @param query The pattern and search options.
+ */
+void SearchEngine::search(const QString& text, const Query& query) {
+    cancel();
+    results.clear();
+    error.clear();
+    emit matchesChanged();
+
+    if (query.pattern.isEmpty()) {
+        emit finished(0);
+        return;
+    }
+
+    running = true;
+    auto deliver = [this](int id, const QVector<TextMatch>& batch) {
+        QMetaObject::invokeMethod(this, [this, id, batch]() { addMatches(id, batch); }, Qt::QueuedConnection);
+    };
+    auto done = [this](int id, const QString& message) {
+        QMetaObject::invokeMethod(this, [this, id, message]() { finish(id, message); }, Qt::QueuedConnection);
+    };
+    pool.start(new SearchTask(text, query, generation, deliver, done));
+}
+
+/**
+ * @brief Stops the running search. Matches found so far are kept.
+ */
+void SearchEngine::cancel() {
+    generation->fetchAndAddOrdered(1);
+    running = false;
+}
+
+/**
+ * @brief Returns the matches starting inside a range of the text.
+ * @param start The first position of the range.
+ * @param end The position after the range.
+ * @return The index range [first, last) into matches().
+ */
+QPair<int, int> SearchEngine::matchRange(int start, int end) const {
+    auto byPosition = [](const TextMatch& match, int position) { return match.position < position; };
+    auto first = std::lower_bound(results.begin(), results.end(), start, byPosition);
+    auto last = std::lower_bound(first, results.end(), end, byPosition);
+    return qMakePair(int(first - results.begin()), int(last - results.begin()));
+}
+
+/**
+ * @brief Finds the first match starting after a position, wrapping around.
+ * @param position The current position.
+ * @return The match index, or -1 if there is no match.
+ */
+int SearchEngine::nextMatch(int position) const {
+    if (results.isEmpty()) {
+        return -1;
+    }
+    auto it = std::upper_bound(results.begin(), results.end(), position,
+                               [](int value, const TextMatch& match) { return value < match.position; });
+    return it != results.end() ? int(it - results.begin()) : 0;
+}
+
+/**
+ * @brief Finds the last match starting before a position, wrapping around.
+ * @param position The current position.
+ * @return The match index, or -1 if there is no match.
+ */
+int SearchEngine::previousMatch(int position) const {
+    if (results.isEmpty()) {
+        return -1;
+    }
+    auto it = std::lower_bound(results.begin(), results.end(), position,
+                               [](const TextMatch& match, int value) { return match.position < value; });
+    return it != results.begin() ? int(it - results.begin()) - 1 : results.size() - 1;
+}
+
+/**
+ * @brief Appends a batch of matches delivered by the worker.
+ * @param id The generation of the search that produced the batch.
+ * @param batch The matches, in text order.
+ */
+void SearchEngine::addMatches(int id, const QVector<TextMatch>& batch) {
+    if (id != generation->loadAcquire()) {
+        return; // Stale search
+    }
+    results.append(batch);
+    emit matchesChanged();
+}
+
+/**
+ * @brief Marks a search as finished.
+ * @param id The generation of the finished search.
+ * @param message The error message, empty on success.
+ */
+void SearchEngine::finish(int id, const QString& message) {
+    if (id != generation->loadAcquire()) {
+        return;
+    }
+    running = false;
+    error = message;
+    emit finished(results.size());
+}
+
+/**
+ * @class TextMatcher
+ * @brief Matches a search query in texts, the same way in the editor and the large file view.
+ *
+ * Literal queries use a QStringMatcher, regular expressions are compiled
+ * once with '^' and '$' matching at line boundaries. Empty matches are
+ * skipped, since they cannot be highlighted. A matcher holds no state
+ * between calls and may be used from a worker thread.
+ */
+
+/**
+ * @brief Prepares the matching of a query.
+ * @param query The pattern and search options.
+ */
+TextMatcher::TextMatcher(const SearchEngine::Query& query)
+    : regularExpression(query.regularExpression)
+    , patternLength(query.pattern.length())
+    , matcher(query.pattern, query.caseSensitive ? Qt::CaseSensitive : Qt::CaseInsensitive)
+{
+    if (regularExpression) {
+        QRegularExpression::PatternOptions options = QRegularExpression::MultilineOption;
+        if (!query.caseSensitive) {
+            options |= QRegularExpression::CaseInsensitiveOption;
+        }
+        expression = QRegularExpression(query.pattern, options);
+        if (!expression.isValid()) {
+            error = expression.errorString();
+        }
+    }
+}
+
+/**
+ * @brief Finds the first non-empty match starting in a range of a text.
+ *
+ * A literal match may end after the range, and only the characters it
+ * needs are read. A regular expression is matched against the text up to the
+ * end of the line MaxMatchSpan characters past the range, so a scan of one
+ * range stays bounded; longer matches starting in the range are cut there.
+ * The whole text remains the subject before the range, for lookbehinds.
+ *
+ * @param text The text to search.
+ * @param from The position to start at.
+ * @param to The position the match has to start before.
+ * @param length Receives the length of the match.
+ * @return The position of the match, or -1 if there is none.
+ */
+int TextMatcher::indexIn(const QString& text, int from, int to, int& length) const {
+    if (!regularExpression) {
+        length = patternLength;
+        if (patternLength == 0 || from >= to) {
+            return -1;
+        }
+        int end = int(qMin<qint64>(text.size(), qint64(to) + patternLength - 1));
+        return matcher.indexIn(text.constData(), end, from);
+    }
+    if (!isValid() || from > text.size() || from >= to) {
+        return -1;
+    }
+    int limit = text.size();
+    if (qint64(to) + MaxMatchSpan < text.size()) {
+        // Up to the end of that line, unless the line is very long
+        const QChar* data = text.constData();
+        const QChar* last = data + qMin<qint64>(text.size(), qint64(to) + 2 * MaxMatchSpan);
+        limit = int(std::find(data + to + MaxMatchSpan, last, QLatin1Char('\n')) - data);
+    }
+    const QStringRef subject = text.leftRef(limit);
+    QRegularExpressionMatch match = expression.match(subject, from);
+    while (match.hasMatch() && match.capturedLength() == 0 && match.capturedStart() < to) {
+        match = expression.match(subject, match.capturedStart() + 1);
+    }
+    length = match.capturedLength();
+    return match.hasMatch() && match.capturedStart() < to ? match.capturedStart() : -1;
+}
@@ -0,0 +1,144 @@
+#include "../includes/search_results_panel.hpp"
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QDir>
+
+namespace {
+const int PathRole = Qt::UserRole;
+const int LineRole = Qt::UserRole + 1;
+const int ColumnRole = Qt::UserRole + 2;
+}
+
+/**
+ * @class SearchResultsPanel
+ * @brief Find-in-files query field and streaming results tree.
+ *
+ * Matches are grouped under one item per file and added as the project search
+ * reports them. Activating a match asks the main window to open it.
+ */
+
+SearchResultsPanel::SearchResultsPanel(QWidget* parent)
+    : QWidget(parent)
+    , titleLabel(new QLabel("Find in Files", this))
+    , searchEdit(new QLineEdit(this))
+    , caseCheckBox(new QCheckBox("Match case", this))
+    , regexCheckBox(new QCheckBox("Regex", this))
+    , resultsTree(new QTreeWidget(this))
+    , statusLabel(new QLabel(this))
+{
+    setupUi();
+}
+
+void SearchResultsPanel::setupUi()
+{
+    QVBoxLayout* mainLayout = new QVBoxLayout(this);
+    mainLayout->setContentsMargins(10, 10, 10, 10);
+    mainLayout->setSpacing(5);
+
+    // Style the title like the output display
+    titleLabel->setStyleSheet(
+        "QLabel {"
+        "   color: #2c3e50;"
+        "   font-size: 14px;"
+        "   font-weight: bold;"
+        "   padding: 5px;"
+        "   border-bottom: 2px solid #3498db;"
+        "}"
+    );
+
+    searchEdit->setPlaceholderText("Search the project...");
+    searchEdit->setClearButtonEnabled(true);
+
+    QHBoxLayout* optionsLayout = new QHBoxLayout();
+    optionsLayout->setContentsMargins(0, 0, 0, 0);
+    optionsLayout->addWidget(caseCheckBox);
+    optionsLayout->addWidget(regexCheckBox);
+    optionsLayout->addStretch();
+
+    resultsTree->setHeaderHidden(true);
+    resultsTree->setUniformRowHeights(true);
+    resultsTree->setMinimumHeight(150);
+
+    mainLayout->addWidget(titleLabel);
+    mainLayout->addWidget(searchEdit);
+    mainLayout->addLayout(optionsLayout);
+    mainLayout->addWidget(resultsTree, 1);
+    mainLayout->addWidget(statusLabel);
+
+    connect(searchEdit, &QLineEdit::returnPressed, this, &SearchResultsPanel::searchRequested);
+    connect(resultsTree, &QTreeWidget::itemActivated, this, [this](QTreeWidgetItem* item) {
+        if (item->data(0, LineRole).isValid()) {
+            emit matchActivated(item->data(0, PathRole).toString(),
+                                item->data(0, LineRole).toInt(),
+                                item->data(0, ColumnRole).toInt());
+        }
+    });
+}
+
+/**
+ * @brief Returns the query currently entered in the panel.
+ * @return The search pattern and options.
+ */
+SearchEngine::Query SearchResultsPanel::query() const
+{
+    SearchEngine::Query query;
+    query.pattern = searchEdit->text();
+    query.caseSensitive = caseCheckBox->isChecked();
+    query.regularExpression = regexCheckBox->isChecked();
+    return query;
+}
+
+/**
+ * @brief Shows the panel and focuses the search field with its text selected.
+ */
+void SearchResultsPanel::activate()
+{
+    show();
+    searchEdit->setFocus();
+    searchEdit->selectAll();
+}
+
+/**
+ * @brief Clears the results before a new search.
+ * @param rootPath The searched directory, used to shorten file paths.
+ */
+void SearchResultsPanel::startResults(const QString& rootPath)
+{
+    this->rootPath = rootPath;
+    resultsTree->clear();
+    fileItems.clear();
+    setStatus("Searching...");
+}
+
+/**
+ * @brief Adds matches to the results tree.
+ * @param matches The matches, grouped by file.
+ */
+void SearchResultsPanel::addMatches(const QVector<FileMatch>& matches)
+{
+    QDir root(rootPath);
+    for (const FileMatch& match : matches) {
+        QTreeWidgetItem*& fileItem = fileItems[match.filePath];
+        if (!fileItem) {
+            fileItem = new QTreeWidgetItem(resultsTree);
+            fileItem->setText(0, root.relativeFilePath(match.filePath));
+            fileItem->setData(0, PathRole, match.filePath);
+            fileItem->setExpanded(true);
+        }
+
+        QTreeWidgetItem* item = new QTreeWidgetItem(fileItem);
+        item->setText(0, QString("%1: %2").arg(match.line).arg(match.preview));
+        item->setData(0, PathRole, match.filePath);
+        item->setData(0, LineRole, match.line);
+        item->setData(0, ColumnRole, match.column);
+    }
+}
+
+/**
+ * @brief Shows the progress or the result of the search.
+ * @param status The text to show.
+ */
+void SearchResultsPanel::setStatus(const QString& status)
+{
+    statusLabel->setText(status);
+}
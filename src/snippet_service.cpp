@@ -0,0 +1,142 @@
+#include "../includes/snippet_service.hpp"
+#include "../includes/finding_index.hpp"
+#include <QFileInfo>
+#include <QDir>
+#include <QMutexLocker>
+
+/**
+ * @class SnippetService
+ * @brief Serves the source lines around findings, read from the files themselves.
+ *
+ * Analyzers do not need to embed code snippets in their SARIF output: the
+ * views ask for the lines of a finding when they display it. Source files are
+ * memory-mapped and their line offsets indexed once (see MappedText); the
+ * mapped files are shared by every caller and kept in a small least recently
+ * used cache, so showing many findings of the same file costs one index and
+ * only the pages of the requested lines are read. A file that changed on
+ * disk since it was mapped is mapped again. The service may be used from any
+ * thread.
+ */
+
+namespace {
+const int MaxMappedFiles = 32;
+const int MaxSnippetLines = 20;
+
+// Lines are clipped, so a minified file cannot flood a popup
+const int MaxSnippetLineBytes = 240;
+}
+
+/**
+ * @brief Returns the service shared by the application.
+ * @return The snippet service.
+ */
+SnippetService& SnippetService::instance() {
+    static SnippetService service;
+    return service;
+}
+
+/**
+ * @brief Sets the directory relative paths reported by the analyzers are resolved against.
+ * @param path The source root, typically the project directory.
+ */
+void SnippetService::setSourceRoot(const QString& path) {
+    QMutexLocker locker(&mutex);
+    sourceRoot = path;
+}
+
+/**
+ * @brief Returns the lines of a finding with some context around them.
+ * @param path The source file, as reported in the finding.
+ * @param line The first line of the finding (1-based).
+ * @param endLine The last line of the finding, 0 for a single line.
+ * @param contextLines The number of lines shown before and after.
+ * @return The lines, empty if the file or the line does not exist.
+ */
+SnippetService::Snippet SnippetService::snippet(const QString& path, int line, int endLine, int contextLines) {
+    Snippet result;
+    QSharedPointer<MappedText> text = open(path);
+    if (!text || line < 1 || line > text->lineCount()) {
+        return result;
+    }
+
+    int first = qMax(1, line - contextLines);
+    int last = qMin(text->lineCount(), qMax(line, endLine) + contextLines);
+    last = qMin(last, first + MaxSnippetLines - 1);
+
+    result.firstLine = first;
+    result.focusLine = line;
+    for (int number = first; number <= last; ++number) {
+        result.lines.append(text->lineText(number - 1, MaxSnippetLineBytes));
+    }
+    return result;
+}
+
+/**
+ * @brief Returns a single source line.
+ * @param path The source file, as reported in the finding.
+ * @param line The line (1-based).
+ * @return The clipped line text, a null string if it does not exist.
+ */
+QString SnippetService::lineText(const QString& path, int line) {
+    Snippet result = snippet(path, line);
+    return result.isEmpty() ? QString() : result.lines.first();
+}
+
+/**
+ * @brief Drops the cached mapping of a file, for instance after it was saved.
+ * @param path The source file.
+ */
+void SnippetService::invalidate(const QString& path) {
+    QMutexLocker locker(&mutex);
+    QString key = resolve(path);
+    entries.remove(key);
+    recent.removeOne(key);
+}
+
+/**
+ * @brief Returns the mapped file, mapping it if needed.
+ * @param path The source file, as reported in the finding.
+ * @return The mapped file, null if it cannot be opened.
+ */
+QSharedPointer<MappedText> SnippetService::open(const QString& path) {
+    QMutexLocker locker(&mutex);
+    const QString key = resolve(path);
+    QFileInfo info(key);
+    if (!info.isFile()) {
+        return QSharedPointer<MappedText>();
+    }
+
+    auto it = entries.find(key);
+    if (it != entries.end() && it->modified == info.lastModified() && it->size == info.size()) {
+        recent.removeOne(key);
+        recent.append(key);
+        return it->text;
+    }
+
+    QSharedPointer<MappedText> text(new MappedText());
+    if (!text->open(key)) {
+        return QSharedPointer<MappedText>();
+    }
+
+    // Callers still holding an evicted file keep it mapped until they are done
+    entries.insert(key, Entry{text, info.lastModified(), info.size()});
+    recent.removeOne(key);
+    recent.append(key);
+    while (recent.size() > MaxMappedFiles) {
+        entries.remove(recent.takeFirst());
+    }
+    return text;
+}
+
+/**
+ * @brief Turns a reported path into the path of the file on disk.
+ * @param path The path or file URI of the finding.
+ * @return The cleaned absolute path when a source root is set.
+ */
+QString SnippetService::resolve(const QString& path) const {
+    QString normalized = FindingIndex::normalizePath(path);
+    if (!sourceRoot.isEmpty() && QDir::isRelativePath(normalized)) {
+        return QDir::cleanPath(QDir(sourceRoot).filePath(normalized));
+    }
+    return normalized;
+}
@@ -0,0 +1,78 @@
+#include "../includes/source_editor.hpp"
+#include <QPlainTextDocumentLayout>
+#include <QScrollBar>
+
+/**
+ * @class SourceEditor
+ * @brief Plain text editor showing the source files.
+ *
+ * The text lives in a QTextDocument, whose storage is already a piece table:
+ * an edit inserts or removes a fragment and never moves the rest of the
+ * text, so a keystroke costs the same in a small and in a multi-megabyte
+ * file. What made the rich text editor expensive was its layout, which lays
+ * out the whole document as frames and keeps it laid out. Here the document
+ * uses the plain text layout instead: blocks are laid out lazily when they
+ * are painted, each one independently with its layout cached in the block,
+ * and an edit only lays out the blocks it touches. The vertical scroll bar
+ * counts lines rather than pixels.
+ *
+ * The document keeps emitting the signals the rest of the editor follows
+ * (contentsChange, contentsChanged, blockCountChanged and
+ * modificationChanged), and extra selections and cursors work as before.
+ */
+
+/**
+ * @brief Creates an editor on an empty plain text document.
+ * @param parent The parent widget.
+ */
+SourceEditor::SourceEditor(QWidget* parent)
+    : QPlainTextEdit(parent)
+{
+}
+
+/**
+ * @brief Gives a document the plain text layout the editor requires.
+ *
+ * Must be called before the document is filled, since changing the layout
+ * of a document lays it out again. May be called from the thread that owns
+ * the document.
+ *
+ * @param document The document to prepare.
+ */
+void SourceEditor::prepareDocument(QTextDocument* document) {
+    if (!qobject_cast<QPlainTextDocumentLayout*>(document->documentLayout())) {
+        document->setDocumentLayout(new QPlainTextDocumentLayout(document));
+    }
+}
+
+/**
+ * @brief Returns the geometry of a block in viewport coordinates.
+ * @param block The block, which is laid out if needed.
+ * @return The bounding rectangle of the block.
+ */
+QRectF SourceEditor::blockGeometry(const QTextBlock& block) const {
+    return blockBoundingGeometry(block).translated(contentOffset());
+}
+
+/**
+ * @brief Scrolls so that a block is in the middle of the viewport, without moving the cursor.
+ * @param block The block to show.
+ */
+void SourceEditor::centerOnBlock(const QTextBlock& block) {
+    QScrollBar* scrollBar = verticalScrollBar();
+    scrollBar->setValue(block.firstLineNumber() - scrollBar->pageStep() / 2);
+}
+
+/**
+ * @brief Switches the editor to or from the mode used for files with very long lines.
+ *
+ * Long lines are not wrapped: a wrapped block of minified code spans
+ * thousands of visual lines that are laid out and counted by the scroll bar
+ * as a whole, while an unwrapped one is a single line that is only shaped
+ * once and scrolled horizontally. The document stays fully editable.
+ *
+ * @param enabled True for documents with very long lines.
+ */
+void SourceEditor::setLongLineMode(bool enabled) {
+    setLineWrapMode(enabled ? QPlainTextEdit::NoWrap : QPlainTextEdit::WidgetWidth);
+}
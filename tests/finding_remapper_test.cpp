@@ -0,0 +1,155 @@
+#include "../includes/finding_remapper.hpp"
+#include "../includes/line_diff.hpp"
+#include <QtTest>
+
+/**
+ * @class FindingRemapperTest
+ * @brief Checks the line diff and how findings follow the edits made after an analysis.
+ */
+class FindingRemapperTest : public QObject {
+    Q_OBJECT
+
+private slots:
+    void diffOfIdenticalLinesIsEmpty();
+    void diffReportsInsertedDeletedAndModifiedLines();
+    void diffIsAbandonedBeyondMaxEdits();
+    void insertedLinesShiftFindings();
+    void reindentedLinesMoveColumns();
+    void deletedLinesDropFindings();
+    void modifiedLinesMarkFindingsStale();
+    void editsElsewhereDoNotChangeFindings();
+    void linesInsertedWithinAFindingChangeIt();
+
+private:
+    static QStringList analysedLines();
+    static FindingSnapshot finding(int line, int endLine, int column);
+};
+
+namespace {
+const QString FilePath = "src/main.cpp";
+
+bool operator==(const LineDiff::Hunk& a, const LineDiff::Hunk& b) {
+    return a.oldStart == b.oldStart && a.oldCount == b.oldCount &&
+           a.newStart == b.newStart && a.newCount == b.newCount;
+}
+}
+
+/**
+ * @brief Returns the file as it was analysed.
+ * @return The analysed lines.
+ */
+QStringList FindingRemapperTest::analysedLines() {
+    return {"int main() {", "    int x = 0;", "    return x;", "}"};
+}
+
+/**
+ * @brief Returns a snapshot holding a single finding of the analysed file.
+ * @param line The first line of the finding (1-based).
+ * @param endLine The last line of the finding.
+ * @param column The start column of the finding.
+ * @return The snapshot.
+ */
+FindingSnapshot FindingRemapperTest::finding(int line, int endLine, int column) {
+    AuditResult result("🚨 test Security Issue");
+    result.setFilePath(FilePath);
+    result.setLine(line);
+    result.setColumn(column);
+    result.setEndLine(endLine);
+    result.setEndColumn(column + 1);
+    result.setRuleId("uninitialized");
+    result.setFingerprint(1);
+    return FindingStore::fromResults({result});
+}
+
+void FindingRemapperTest::diffOfIdenticalLinesIsEmpty() {
+    QVector<LineDiff::Hunk> hunks;
+    QVector<uint> lines = LineDiff::hashLines(analysedLines());
+    QVERIFY(LineDiff::compute(lines, lines, 100, hunks));
+    QVERIFY(hunks.isEmpty());
+}
+
+void FindingRemapperTest::diffReportsInsertedDeletedAndModifiedLines() {
+    QVector<LineDiff::Hunk> hunks;
+    QVERIFY(LineDiff::compute({1, 2, 3}, {0, 1, 2, 3}, 100, hunks));
+    QCOMPARE(hunks.size(), 1);
+    QVERIFY(hunks[0] == (LineDiff::Hunk{0, 0, 0, 1}));
+
+    QVERIFY(LineDiff::compute({1, 2, 3}, {1, 3}, 100, hunks));
+    QCOMPARE(hunks.size(), 1);
+    QVERIFY(hunks[0] == (LineDiff::Hunk{1, 1, 1, 0}));
+
+    QVERIFY(LineDiff::compute({1, 2, 3, 4, 5}, {1, 9, 3, 8, 5}, 100, hunks));
+    QCOMPARE(hunks.size(), 2);
+    QVERIFY(hunks[0] == (LineDiff::Hunk{1, 1, 1, 1}));
+    QVERIFY(hunks[1] == (LineDiff::Hunk{3, 1, 3, 1}));
+}
+
+void FindingRemapperTest::diffIsAbandonedBeyondMaxEdits() {
+    QVector<LineDiff::Hunk> hunks;
+    QVERIFY(!LineDiff::compute({1, 2, 3, 4, 5}, {1, 9, 3, 8, 5}, 2, hunks));
+}
+
+void FindingRemapperTest::insertedLinesShiftFindings() {
+    FindingSnapshot findings = finding(2, 2, 9);
+    FindingRemapper remapper(analysedLines(), {"// header", "", "int main() {", "    int x = 0;", "    return x;", "}"});
+    QVERIFY(remapper.isValid());
+    QVERIFY(!remapper.changesFindings(findings, FilePath));
+
+    FindingSnapshot remapped = remapper.remap(findings, FilePath);
+    QCOMPARE(remapped->size(), 1);
+    QCOMPARE(remapped->line(0), 4);
+    QCOMPARE(remapped->endLine(0), 4);
+    QCOMPARE(remapped->column(0), 9);
+    QVERIFY(!remapped->isStale(0));
+}
+
+void FindingRemapperTest::reindentedLinesMoveColumns() {
+    FindingSnapshot findings = finding(2, 2, 9);
+    FindingRemapper remapper(analysedLines(), {"int main() {", "        int x = 0;", "    return x;", "}"});
+    QVERIFY(!remapper.hasCodeChanges());
+
+    FindingSnapshot remapped = remapper.remap(findings, FilePath);
+    QCOMPARE(remapped->line(0), 2);
+    QCOMPARE(remapped->column(0), 13);
+    QVERIFY(!remapped->isStale(0));
+}
+
+void FindingRemapperTest::deletedLinesDropFindings() {
+    FindingSnapshot findings = finding(2, 2, 9);
+    FindingRemapper remapper(analysedLines(), {"int main() {", "    return x;", "}"});
+    QVERIFY(remapper.changesFindings(findings, FilePath));
+    QCOMPARE(remapper.remap(findings, FilePath)->size(), 0);
+}
+
+void FindingRemapperTest::modifiedLinesMarkFindingsStale() {
+    FindingSnapshot findings = finding(2, 2, 9);
+    FindingRemapper remapper(analysedLines(), {"int main() {", "    int x = 42;", "    return x;", "}"});
+    QVERIFY(remapper.changesFindings(findings, FilePath));
+
+    FindingSnapshot remapped = remapper.remap(findings, FilePath);
+    QCOMPARE(remapped->size(), 1);
+    QCOMPARE(remapped->line(0), 2);
+    QCOMPARE(remapped->column(0), 9);
+    QVERIFY(remapped->isStale(0));
+}
+
+void FindingRemapperTest::editsElsewhereDoNotChangeFindings() {
+    FindingSnapshot findings = finding(2, 2, 9);
+    FindingRemapper remapper(analysedLines(), {"int main() {", "    int x = 0;", "    return x + 1;", "}"});
+    QVERIFY(remapper.hasCodeChanges());
+    QVERIFY(!remapper.changesFindings(findings, FilePath));
+    QVERIFY(!remapper.remap(findings, FilePath)->isStale(0));
+}
+
+void FindingRemapperTest::linesInsertedWithinAFindingChangeIt() {
+    FindingSnapshot findings = finding(2, 3, 5);
+    FindingRemapper remapper(analysedLines(), {"int main() {", "    int x = 0;", "    x++;", "    return x;", "}"});
+    QVERIFY(remapper.changesFindings(findings, FilePath));
+
+    FindingSnapshot remapped = remapper.remap(findings, FilePath);
+    QCOMPARE(remapped->line(0), 2);
+    QCOMPARE(remapped->endLine(0), 4);
+}
+
+QTEST_APPLESS_MAIN(FindingRemapperTest)
+#include "finding_remapper_test.moc"
@@ -0,0 +1,79 @@
+#include "../includes/main_window.hpp"
+#include <QtTest>
+#include <QTemporaryDir>
+#include <QFile>
+
+/**
+ * @class MainWindowTest
+ * @brief Checks how the main window switches between the files it shows.
+ */
+class MainWindowTest : public QObject {
+    Q_OBJECT
+
+private slots:
+    void opensLargeFilesOneAfterTheOther();
+
+private:
+    static QString writeLargeFile(const QTemporaryDir& directory, const QString& name, int lineLength, int& lines);
+};
+
+namespace {
+// Large enough for the read-only large file view
+const qint64 LargeFileSize = 16 * 1024 * 1024;
+}
+
+/**
+ * @brief Writes a file opened in the large file view.
+ * @param directory The directory of the file.
+ * @param name The file name.
+ * @param lineLength The length of every line, its newline included.
+ * @param lines Receives the number of lines.
+ * @return The path of the file, empty if it cannot be written.
+ */
+QString MainWindowTest::writeLargeFile(const QTemporaryDir& directory, const QString& name, int lineLength,
+                                       int& lines) {
+    QString path = directory.filePath(name);
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return QString();
+    }
+    QByteArray line(lineLength - 1, 'x');
+    line.append('\n');
+    QByteArray block = line.repeated(4096);
+    lines = 0;
+    while (file.size() < LargeFileSize) {
+        file.write(block);
+        lines += 4096;
+    }
+    return path;
+}
+
+void MainWindowTest::opensLargeFilesOneAfterTheOther() {
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    int firstLines = 0;
+    int secondLines = 0;
+    QString first = writeLargeFile(directory, "first.log", 64, firstLines);
+    QString second = writeLargeFile(directory, "second.log", 32, secondLines);
+    QVERIFY(MainWindow::opensReadOnly(first));
+    QVERIFY(MainWindow::opensReadOnly(second));
+
+    MainWindow window;
+    LargeFileView* view = window.getLargeFileView();
+    QVERIFY(window.openFile(first));
+    QCOMPARE(view->filePath(), first);
+    QCOMPARE(view->lineCount(), firstLines);
+
+    // Opening another large file replaces the mapped file instead of closing it
+    QVERIFY(window.openFile(second));
+    QCOMPARE(view->filePath(), second);
+    QCOMPARE(view->lineCount(), secondLines);
+
+    // Going back to the first tab maps the first file again
+    QVERIFY(window.openFile(first));
+    QCOMPARE(view->filePath(), first);
+    QCOMPARE(view->lineCount(), firstLines);
+}
+
+QTEST_MAIN(MainWindowTest)
+#include "main_window_test.moc"
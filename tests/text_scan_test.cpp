@@ -0,0 +1,216 @@
+#include "../includes/line_index.hpp"
+#include "../includes/mapped_text.hpp"
+#include <QtTest>
+#include <QTemporaryFile>
+
+/**
+ * @class TextScanTest
+ * @brief Checks that the SSE2 line scans agree with the scalar ones, and the column conversions.
+ */
+class TextScanTest : public QObject {
+    Q_OBJECT
+
+private slots:
+    void scanLines_data();
+    void scanLines();
+    void scanNewlines_data();
+    void scanNewlines();
+    void scansAgreeAtEveryPosition();
+    void lineIndexColumnOffsets();
+    void mappedTextColumnOffsets();
+    void mappedTextTrailingNewline_data();
+    void mappedTextTrailingNewline();
+
+private:
+    static void addTexts();
+    static void compareLineScans(const QString& text);
+    static void compareNewlineScans(const QByteArray& bytes);
+};
+
+/**
+ * @brief Adds the texts both scans are compared on.
+ */
+void TextScanTest::addTexts() {
+    QTest::addColumn<QString>("text");
+    QTest::addColumn<QVector<int>>("lineStarts");
+    QTest::addColumn<QVector<bool>>("asciiLines");
+
+    QTest::newRow("empty") << QString() << QVector<int>{0} << QVector<bool>{true};
+    QTest::newRow("shorter than a chunk") << QString("abc") << QVector<int>{0} << QVector<bool>{true};
+    QTest::newRow("newline ending the first chunk") << QString("0123456\n89abcdef")
+                                                    << QVector<int>{0, 8} << QVector<bool>{true, true};
+    QTest::newRow("newline starting the second chunk") << QString("01234567\n9abcdef")
+                                                       << QVector<int>{0, 9} << QVector<bool>{true, true};
+    QTest::newRow("newline ending a byte chunk") << QString("0123456789abcde\nx")
+                                                 << QVector<int>{0, 16} << QVector<bool>{true, true};
+    QTest::newRow("non-ASCII before a newline") << QString::fromUtf8("aaaaaaé\nbbbbbbb")
+                                                << QVector<int>{0, 8} << QVector<bool>{false, true};
+    QTest::newRow("non-ASCII after a newline") << QString::fromUtf8("aaaaaaa\nébbbbbbbb")
+                                               << QVector<int>{0, 8} << QVector<bool>{true, false};
+    QTest::newRow("surrogate pair across chunks") << QString::fromUtf8("abcdefg\U0001F600\nxyz")
+                                                  << QVector<int>{0, 10} << QVector<bool>{false, true};
+    QTest::newRow("trailing newline") << QString("abcdefghijklmnopq\n") << QVector<int>{0} << QVector<bool>{true};
+    QTest::newRow("empty lines") << QString("a\n\n\nb\n") << QVector<int>{0, 2, 3, 4}
+                                 << QVector<bool>{true, true, true, true};
+    QTest::newRow("odd size") << QString("line one\nline two\nline three")
+                              << QVector<int>{0, 9, 18} << QVector<bool>{true, true, true};
+}
+
+/**
+ * @brief Checks that both line scans of a text give the same lines.
+ * @param text The text.
+ */
+void TextScanTest::compareLineScans(const QString& text) {
+    QVector<int> vectorStarts;
+    QVector<int> scalarStarts;
+    QVector<bool> vectorAscii;
+    QVector<bool> scalarAscii;
+    LineIndex::scanLines(text.constData(), text.size(), vectorStarts, vectorAscii, true);
+    LineIndex::scanLines(text.constData(), text.size(), scalarStarts, scalarAscii, false);
+    QCOMPARE(vectorStarts, scalarStarts);
+    QCOMPARE(vectorAscii, scalarAscii);
+}
+
+/**
+ * @brief Checks that both newline scans of a buffer give the same lines.
+ * @param bytes The buffer.
+ */
+void TextScanTest::compareNewlineScans(const QByteArray& bytes) {
+    QVector<qint64> vectorStarts;
+    QVector<qint64> scalarStarts;
+    MappedText::scanNewlines(bytes.constData(), bytes.size(), vectorStarts, true);
+    MappedText::scanNewlines(bytes.constData(), bytes.size(), scalarStarts, false);
+    QCOMPARE(vectorStarts, scalarStarts);
+}
+
+void TextScanTest::scanLines_data() {
+    addTexts();
+}
+
+void TextScanTest::scanLines() {
+    QFETCH(QString, text);
+    QFETCH(QVector<int>, lineStarts);
+    QFETCH(QVector<bool>, asciiLines);
+
+    QVector<int> starts;
+    QVector<bool> ascii;
+    LineIndex::scanLines(text.constData(), text.size(), starts, ascii);
+    QCOMPARE(starts, lineStarts);
+    QCOMPARE(ascii, asciiLines);
+    compareLineScans(text);
+}
+
+void TextScanTest::scanNewlines_data() {
+    addTexts();
+}
+
+void TextScanTest::scanNewlines() {
+    QFETCH(QString, text);
+    QByteArray bytes = text.toUtf8();
+
+    // Same lines as the UTF-16 scan, at byte offsets
+    QVector<qint64> expected{0};
+    for (int i = 0; i + 1 < bytes.size(); ++i) {
+        if (bytes[i] == '\n') {
+            expected.append(i + 1);
+        }
+    }
+
+    QVector<qint64> starts;
+    MappedText::scanNewlines(bytes.constData(), bytes.size(), starts);
+    QCOMPARE(starts, expected);
+    compareNewlineScans(bytes);
+}
+
+void TextScanTest::scansAgreeAtEveryPosition() {
+    // Every size around the 8 and 16 unit chunks, with a newline or a
+    // non-ASCII character at every position
+    for (int size = 0; size <= 40; ++size) {
+        for (int position = 0; position < size; ++position) {
+            QString text(size, QChar('x'));
+            text[position] = QChar('\n');
+            compareLineScans(text);
+            compareNewlineScans(text.toUtf8());
+
+            text[qMax(0, position - 1)] = QChar(0x00e9);
+            compareLineScans(text);
+            compareNewlineScans(text.toUtf8());
+
+            text[position] = QChar(0x4e2d);
+            compareLineScans(text);
+            compareNewlineScans(text.toUtf8());
+        }
+    }
+}
+
+void TextScanTest::lineIndexColumnOffsets() {
+    // 'a', U+00E9 (2 UTF-8 bytes), U+1F600 (a surrogate pair, 4 bytes), 'b'
+    const QString line = QString::fromUtf8("aé\U0001F600b");
+    QCOMPARE(line.size(), 5);
+    auto offset = [&line](int column, AuditResult::ColumnKind kind) {
+        return LineIndex::columnOffset(line.constData(), line.size(), column, kind);
+    };
+
+    QCOMPARE(offset(1, AuditResult::Utf16CodeUnits), 0);
+    QCOMPARE(offset(5, AuditResult::Utf16CodeUnits), 4);
+    QCOMPARE(offset(9, AuditResult::Utf16CodeUnits), 5);
+
+    QCOMPARE(offset(3, AuditResult::UnicodeCodePoints), 2);
+    QCOMPARE(offset(4, AuditResult::UnicodeCodePoints), 4);
+
+    QCOMPARE(offset(2, AuditResult::Utf8Bytes), 1);
+    QCOMPARE(offset(3, AuditResult::Utf8Bytes), 1);
+    QCOMPARE(offset(4, AuditResult::Utf8Bytes), 2);
+    QCOMPARE(offset(5, AuditResult::Utf8Bytes), 2);
+    QCOMPARE(offset(8, AuditResult::Utf8Bytes), 4);
+}
+
+void TextScanTest::mappedTextColumnOffsets() {
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    file.write(QString::fromUtf8("x\naé\U0001F600b\ny").toUtf8());
+    file.close();
+
+    MappedText text;
+    QVERIFY(text.open(file.fileName()));
+    QCOMPARE(text.lineCount(), 3);
+    QCOMPARE(text.lineLength(1), qint64(8));
+
+    QCOMPARE(text.columnOffset(1, 1, AuditResult::Utf8Bytes), qint64(0));
+    QCOMPARE(text.columnOffset(1, 8, AuditResult::Utf8Bytes), qint64(7));
+    QCOMPARE(text.columnOffset(1, 20, AuditResult::Utf8Bytes), qint64(8));
+
+    QCOMPARE(text.columnOffset(1, 3, AuditResult::UnicodeCodePoints), qint64(3));
+    QCOMPARE(text.columnOffset(1, 4, AuditResult::UnicodeCodePoints), qint64(7));
+
+    // The second unit of the surrogate pair maps to the start of the character
+    QCOMPARE(text.columnOffset(1, 3, AuditResult::Utf16CodeUnits), qint64(3));
+    QCOMPARE(text.columnOffset(1, 4, AuditResult::Utf16CodeUnits), qint64(3));
+    QCOMPARE(text.columnOffset(1, 5, AuditResult::Utf16CodeUnits), qint64(7));
+}
+
+void TextScanTest::mappedTextTrailingNewline_data() {
+    QTest::addColumn<QByteArray>("content");
+    QTest::newRow("LF") << QByteArray("x\na\xC3\xA9\xF0\x9F\x98\x80" "b\n");
+    QTest::newRow("CRLF") << QByteArray("x\r\na\xC3\xA9\xF0\x9F\x98\x80" "b\r\n");
+}
+
+void TextScanTest::mappedTextTrailingNewline() {
+    QFETCH(QByteArray, content);
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    file.write(content);
+    file.close();
+
+    MappedText text;
+    QVERIFY(text.open(file.fileName()));
+    QCOMPARE(text.lineCount(), 2);
+    QCOMPARE(text.lineLength(0), qint64(1));
+    QCOMPARE(text.lineLength(1), qint64(8));
+    QCOMPARE(text.longestLine(), 8);
+    QCOMPARE(text.lineText(1), QString::fromUtf8("aé\U0001F600b"));
+    QCOMPARE(text.columnOffset(1, 20, AuditResult::Utf8Bytes), qint64(8));
+}
+
+QTEST_APPLESS_MAIN(TextScanTest)
+#include "text_scan_test.moc"